@@ -33,6 +33,8 @@
 
 #include "Locks/util.h"
 #include "Locks/lock_example.h"
+#include "Runtime/CpuLoad_Example.h"
+#include "Runtime/Idle.h"
 
 IfxCpu_syncEvent g_cpuSyncEvent = 0;
 
@@ -43,6 +45,9 @@ char Core0_Word2 [] = "Brown ";
 void Set_LEDs(void);
 int core0_main(void)
 {
+#if USE_CPU_LOAD
+    initCpuLoadExample();
+#endif
     IfxCpu_enableInterrupts();
     
     /* !!WATCHDOG0 AND SAFETY WATCHDOG ARE DISABLED HERE!!
@@ -70,6 +75,12 @@ int core0_main(void)
     ReleaseLock();
 #endif
 
+#if USE_CPU_LOAD
+    runCpuLoadIdleLoop();
+#elif USE_IDLE
+    initIdle();
+    runIdleLoop();
+#endif
     while(1)
     {
 
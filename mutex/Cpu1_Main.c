@@ -32,6 +32,8 @@
 
 #include "Locks/util.h"
 #include "Locks/lock_example.h"
+#include "Runtime/CpuLoad_Example.h"
+#include "Runtime/Idle.h"
 
 extern IfxCpu_syncEvent g_cpuSyncEvent;
 
@@ -43,6 +45,9 @@ char Core1_Word2 [] = "Jumps ";
 
 int core1_main(void)
 {
+#if USE_CPU_LOAD
+    initCpuLoadExample();
+#endif
     IfxCpu_enableInterrupts();
     
     /* !!WATCHDOG1 IS DISABLED HERE!!
@@ -59,6 +64,12 @@ int core1_main(void)
     Core1_Actions();
 
 
+#if USE_CPU_LOAD
+    runCpuLoadIdleLoop();
+#elif USE_IDLE
+    initIdle();
+    runIdleLoop();
+#endif
     while(1)
     {
 
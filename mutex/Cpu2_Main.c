@@ -32,6 +32,8 @@
 
 #include "Locks/util.h"
 #include "Locks/lock_example.h"
+#include "Runtime/CpuLoad_Example.h"
+#include "Runtime/Idle.h"
 
 extern IfxCpu_syncEvent g_cpuSyncEvent;
 
@@ -43,6 +45,9 @@ char Core2_Word2 [] = "Dog ";
 
 int core2_main(void)
 {
+#if USE_CPU_LOAD
+    initCpuLoadExample();
+#endif
     IfxCpu_enableInterrupts();
     /* !!WATCHDOG1 IS DISABLED HERE!!
      * Enable the watchdog and service it periodically if it is required
@@ -57,6 +62,12 @@ int core2_main(void)
     synchronizeOtherCores();
     Core2_Actions();
 
+#if USE_CPU_LOAD
+    runCpuLoadIdleLoop();
+#elif USE_IDLE
+    initIdle();
+    runIdleLoop();
+#endif
     while(1)
     {
 
@@ -5,6 +5,7 @@
 #include "IfxAsclin_Asc.h"
 #include "Assert.h"
 #include "VCOM.h"
+#include "Runtime/CpuLoad.h"
 #include <stdio.h>
 
 /******************************************************************************/
@@ -34,8 +35,10 @@ IFX_INTERRUPT(ISR_VCOM_0_ex, 0, ISR_PRIORITY_VCOM_0_EX);
  */
 void ISR_VCOM_0_rx(void)
 {
+    CPU_LOAD_ISR_BEGIN(ISR_PRIORITY_VCOM_0_RX);
     IfxCpu_enableInterrupts();
     IfxAsclin_Asc_isrReceive(&g_AsclinAsc.drivers.asc0);
+    CPU_LOAD_ISR_END();
 }
 
 
@@ -50,8 +53,10 @@ void ISR_VCOM_0_rx(void)
  */
 void ISR_VCOM_0_tx(void)
 {
+    CPU_LOAD_ISR_BEGIN(ISR_PRIORITY_VCOM_0_TX);
     IfxCpu_enableInterrupts();
     IfxAsclin_Asc_isrTransmit(&g_AsclinAsc.drivers.asc0);
+    CPU_LOAD_ISR_END();
 }
 
 
@@ -66,8 +71,10 @@ void ISR_VCOM_0_tx(void)
  */
 void ISR_VCOM_0_ex(void)
 {
+    CPU_LOAD_ISR_BEGIN(ISR_PRIORITY_VCOM_0_EX);
     IfxCpu_enableInterrupts();
     IfxAsclin_Asc_isrError(&g_AsclinAsc.drivers.asc0);
+    CPU_LOAD_ISR_END();
 }
 
 void initVCOMSerialInterface(void)
@@ -62,6 +62,7 @@ typedef struct
 IFX_EXTERN App_AsclinAsc g_AsclinAsc;
 
 
+void initVCOMSerialInterface(void);
 void VCOM_Core_Write(char * txbuff);
 
 #endif /* DRIVERS_VCOM_H_ */
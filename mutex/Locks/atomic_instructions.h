@@ -28,17 +28,53 @@
 
 
 
+#ifndef LOCKS_HOST
+#define LOCKS_HOST 0	/* 1: build for a Linux host, see host_port.h */
+#endif
+
+#if LOCKS_HOST
+#include "host_port.h"
+#else
 #include "Platform_Types.h"
+#endif
 
 /* Compile read-write barrier */
 #define barrier() asm volatile("": : :"memory")
 
+/* Hardware barrier: all previous data accesses are completed */
+#define memory_barrier() do { barrier(); __dsync(); barrier(); } while (0)
+
 #ifndef IFX_INLINE
 #define IFX_INLINE         static inline          /* makes the function always inlined */
 #endif
 
 #define LOCK_INLINE IFX_INLINE
 
+#ifndef LOCKS_NUM_CORES
+#define LOCKS_NUM_CORES 3
+#endif
+
+/* index of the executing core (CORE_ID register) */
+IFX_INLINE unsigned int core_id(void)
+{
+	return __mfcr(0xFE1C);
+}
+
+/* CPU clock cycle counter (CCNT register), used for measurements.
+ * On the host this counts nanoseconds. */
+IFX_INLINE unsigned int cycle_count(void)
+{
+	return __mfcr(0xFC04);
+}
+
+/* lets cycle_count() count on the executing core (CCTRL.CE), it is stopped
+ * after reset. To be called once per core before the first measurement. */
+IFX_INLINE void enable_cycle_counter(void)
+{
+	__mtcr(0xFC00, __mfcr(0xFC00) | 0x2);
+	__isync();
+}
+
 /* atomic compare and swap */
 IFX_INLINE boolean cmp_swap(unsigned int* address,
 		unsigned int expected_value, unsigned int new_value)
@@ -74,6 +110,12 @@ IFX_INLINE unsigned int swap_msk(unsigned int* address, unsigned int mask,
 	return swap_lock_value;
 }
 
+/* number of leading zero bits, 32 for 0 */
+IFX_INLINE unsigned int count_leading_zeros(unsigned int value)
+{
+	return __clz(value);
+}
+
 /* software fetch and increment implementation */
 IFX_INLINE unsigned int swap_incr(unsigned int* address)
 {
@@ -82,11 +124,24 @@ IFX_INLINE unsigned int swap_incr(unsigned int* address)
 	do {
 		expected_value = actual_value;
 
-		expected_value = __cmpswapw(address, (actual_value+1), actual_value );
+		actual_value = __cmpswapw(address, (expected_value+1), expected_value );
+
+	} while (expected_value != actual_value);
+	return actual_value;
+}
+
+/* software fetch and add implementation */
+IFX_INLINE unsigned int swap_add(unsigned int* address, unsigned int value)
+{
+	unsigned int actual_value = *address;
+	unsigned int expected_value;
+	do {
+		expected_value = actual_value;
+
+		actual_value = __cmpswapw(address, (expected_value+value), expected_value );
 
-		actual_value = expected_value;
 	} while (expected_value != actual_value);
-	return expected_value;
+	return actual_value;
 }
 
 #endif /* ATOMIC_INSTRUCTIONS_H_ */
@@ -0,0 +1,90 @@
+/**
+ * \file barrier_example.c
+ * \brief Latency of the core barriers.
+ *
+ */
+
+#include "barrier_example.h"
+
+#pragma section fardata "data_cpu0"
+dissemination_node_t bench_node_0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu1"
+dissemination_node_t bench_node_1;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu2"
+dissemination_node_t bench_node_2;
+#pragma section fardata restore
+
+dissemination_node_t* bench_node[LOCKS_NUM_CORES] = { &bench_node_0, &bench_node_1, &bench_node_2 };
+
+#pragma section fardata "lmudata"
+corebarrier_t bench_barrier = COREBARRIER_INIT(LOCKS_NUM_CORES);
+dissemination_barrier_t bench_dissemination;
+volatile unsigned int bench_dissemination_ready = 0;
+volatile unsigned int barrier_bench_central[LOCKS_NUM_CORES];
+volatile unsigned int barrier_bench_dissemination[LOCKS_NUM_CORES];
+volatile unsigned int barrier_bench_work_then_pass[LOCKS_NUM_CORES];
+volatile unsigned int barrier_bench_split_phase[LOCKS_NUM_CORES];
+#pragma section fardata restore
+
+static void localWork(void)
+{
+	volatile unsigned int i;
+	for (i = 0; i < BARRIER_BENCH_WORK; i++)
+		;
+}
+
+void BarrierBenchmark(void)
+{
+	unsigned int me = core_id();
+	unsigned int start;
+	int i;
+
+	if (me == 0)
+	{
+		InitDisseminationBarrier(&bench_dissemination, bench_node, LOCKS_NUM_CORES);
+		bench_dissemination_ready = 1;
+	}
+	while (!bench_dissemination_ready)
+	{
+		__nop();
+	}
+	PassCoreBarrier(&bench_barrier);
+
+	start = cycle_count();
+	for (i = 0; i < BARRIER_BENCH_EPISODES; i++)
+	{
+		PassCoreBarrier(&bench_barrier);
+	}
+	barrier_bench_central[me] = (cycle_count() - start) / BARRIER_BENCH_EPISODES;
+
+	PassCoreBarrier(&bench_barrier);
+	start = cycle_count();
+	for (i = 0; i < BARRIER_BENCH_EPISODES; i++)
+	{
+		PassDisseminationBarrier(&bench_dissemination);
+	}
+	barrier_bench_dissemination[me] = (cycle_count() - start) / BARRIER_BENCH_EPISODES;
+
+	PassCoreBarrier(&bench_barrier);
+	start = cycle_count();
+	for (i = 0; i < BARRIER_BENCH_EPISODES; i++)
+	{
+		localWork();
+		PassCoreBarrier(&bench_barrier);
+	}
+	barrier_bench_work_then_pass[me] = (cycle_count() - start) / BARRIER_BENCH_EPISODES;
+
+	PassCoreBarrier(&bench_barrier);
+	start = cycle_count();
+	for (i = 0; i < BARRIER_BENCH_EPISODES; i++)
+	{
+		unsigned int token = ArriveAtCoreBarrier(&bench_barrier);
+		localWork();
+		WaitAtCoreBarrier(&bench_barrier, token);
+	}
+	barrier_bench_split_phase[me] = (cycle_count() - start) / BARRIER_BENCH_EPISODES;
+}
@@ -0,0 +1,28 @@
+/**
+ * \file barrier_example.h
+ * \brief Latency of the core barriers.
+ *
+ */
+
+
+#ifndef BARRIER_EXAMPLE_H_
+#define BARRIER_EXAMPLE_H_
+
+#include "core_barrier.h"
+
+#define BARRIER_BENCH_EPISODES 		1000
+#define BARRIER_BENCH_WORK 			200		// loop iterations of core local work
+
+// average cycles per barrier episode, per core
+extern volatile unsigned int barrier_bench_central[LOCKS_NUM_CORES];
+extern volatile unsigned int barrier_bench_dissemination[LOCKS_NUM_CORES];
+// average cycles per episode of work followed by the barrier, and of the
+// same work overlapped with the split-phase barrier
+extern volatile unsigned int barrier_bench_work_then_pass[LOCKS_NUM_CORES];
+extern volatile unsigned int barrier_bench_split_phase[LOCKS_NUM_CORES];
+
+void BarrierBenchmark(void);
+// to be called by all cores at the same time, on the host with
+// RunOnHostCores(BarrierBenchmark, LOCKS_NUM_CORES)
+
+#endif /* BARRIER_EXAMPLE_H_ */
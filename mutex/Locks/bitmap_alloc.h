@@ -0,0 +1,123 @@
+/**
+ * \file bitmap_alloc.h
+ * \brief Lock-free bitmap allocator for small fixed-size resources.
+ *
+ */
+
+
+#ifndef BITMAP_ALLOC_H_
+#define BITMAP_ALLOC_H_
+
+#include "atomic_instructions.h"
+
+// One bit per resource (DMA channel, message buffer, timer slot...), set
+// while it is in use. A free bit is claimed with a single swap_msk on that
+// bit: the previous value tells whether we got it or another core or ISR
+// was faster, so no compare and swap loop over the whole word is needed.
+// Every core starts its search at the word it allocated from last time,
+// which keeps the cores apart as long as enough resources are free.
+// Allocation is O(1) typically and O(words) in the worst case.
+
+#define bitmapNONE 				0xFFFFFFFFu
+#define BITMAP_WORDS(bits) 		(((bits) + 31) / 32)
+
+typedef struct bitmap_alloc_t
+{
+	volatile unsigned int* words;
+	unsigned int num_words;
+	unsigned int num_bits;
+	volatile unsigned int hint[LOCKS_NUM_CORES];	// word to start searching at
+} bitmap_alloc_t;
+
+/**
+ * words must hold BITMAP_WORDS(num_bits) entries. All resources are free.
+ * Must be called before any other core or ISR uses the allocator.
+ */
+LOCK_INLINE void InitBitmapAlloc(bitmap_alloc_t* alloc, unsigned int* words,
+		unsigned int num_bits)
+{
+	unsigned int i;
+
+	alloc->words = words;
+	alloc->num_words = BITMAP_WORDS(num_bits);
+	alloc->num_bits = num_bits;
+
+	for (i = 0; i < alloc->num_words; i++)
+	{
+		words[i] = 0;
+	}
+	// bits beyond num_bits are permanently in use
+	if (num_bits % 32)
+	{
+		words[alloc->num_words - 1] = ~((1u << (num_bits % 32)) - 1);
+	}
+	for (i = 0; i < LOCKS_NUM_CORES; i++)
+	{
+		alloc->hint[i] = i * alloc->num_words / LOCKS_NUM_CORES;
+	}
+	barrier();
+}
+
+/**
+ * Claims the given resource, e.g. one specific DMA channel.
+ */
+LOCK_INLINE boolean TryToAllocBitmapBit(bitmap_alloc_t* alloc, unsigned int bit)
+{
+	unsigned int mask = 1u << (bit % 32);
+	return !(swap_msk((unsigned int*) &alloc->words[bit / 32], mask, mask) & mask);
+}
+
+/**
+ * Claims any free resource and returns its index, or bitmapNONE.
+ * Lock-free, may be used from any core and from ISRs.
+ */
+LOCK_INLINE unsigned int AllocBitmap(bitmap_alloc_t* alloc)
+{
+	unsigned int me = core_id();
+	unsigned int start = alloc->hint[me];
+	unsigned int n;
+
+	for (n = 0; n < alloc->num_words; n++)
+	{
+		unsigned int index = start + n;
+		unsigned int free_bits;
+
+		if (index >= alloc->num_words)
+		{
+			index -= alloc->num_words;
+		}
+
+		free_bits = ~alloc->words[index];
+		while (free_bits)
+		{
+			// lowest free bit
+			unsigned int mask = free_bits & (0 - free_bits);
+			unsigned int old_value = swap_msk((unsigned int*) &alloc->words[index], mask, mask);
+
+			if (!(old_value & mask))
+			{
+				alloc->hint[me] = index;
+				return index * 32 + (31 - count_leading_zeros(mask));
+			}
+			// lost the race for this bit, try the others still free
+			free_bits = ~old_value;
+		}
+	}
+	return bitmapNONE;
+}
+
+/**
+ * Releases a resource. Lock-free, may be used from any core and from ISRs.
+ */
+LOCK_INLINE void FreeBitmap(bitmap_alloc_t* alloc, unsigned int bit)
+{
+	unsigned int mask = 1u << (bit % 32);
+	swap_msk((unsigned int*) &alloc->words[bit / 32], mask, 0);
+}
+
+LOCK_INLINE boolean IsBitmapBitUsed(bitmap_alloc_t* alloc, unsigned int bit)
+{
+	return (alloc->words[bit / 32] >> (bit % 32)) & 1;
+}
+
+#endif /* BITMAP_ALLOC_H_ */
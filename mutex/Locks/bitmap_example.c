@@ -0,0 +1,78 @@
+/**
+ * \file bitmap_example.c
+ * \brief Multi-core stress run of the bitmap allocator.
+ *
+ */
+
+#include "bitmap_example.h"
+
+#define OWNER_NONE 0xFFu
+
+#pragma section fardata "lmudata"
+unsigned int stress_words[BITMAP_WORDS(BITMAP_STRESS_RESOURCES)];
+bitmap_alloc_t stress_alloc;
+volatile unsigned char stress_owner[BITMAP_STRESS_RESOURCES];
+volatile unsigned int stress_initialized = 0;
+volatile unsigned int bitmap_stress_errors[LOCKS_NUM_CORES];
+volatile unsigned int bitmap_stress_allocs[LOCKS_NUM_CORES];
+volatile unsigned int bitmap_stress_cycles[LOCKS_NUM_CORES];
+#pragma section fardata restore
+
+void BitmapStress(void)
+{
+	unsigned int me = core_id();
+	unsigned int held[BITMAP_STRESS_HOLD];
+	unsigned int round;
+	unsigned int start;
+	int i;
+
+	if (me == 0)
+	{
+		InitBitmapAlloc(&stress_alloc, stress_words, BITMAP_STRESS_RESOURCES);
+		for (i = 0; i < BITMAP_STRESS_RESOURCES; i++)
+		{
+			stress_owner[i] = OWNER_NONE;
+		}
+		memory_barrier();
+		stress_initialized = 1;
+	}
+	while (!stress_initialized)
+	{
+		__nop();
+	}
+
+	start = cycle_count();
+	for (round = 0; round < BITMAP_STRESS_ROUNDS; round++)
+	{
+		int count = 0;
+
+		// more than the fair share, so the cores really run out of resources
+		while (count < BITMAP_STRESS_HOLD)
+		{
+			unsigned int bit = AllocBitmap(&stress_alloc);
+			if (bit == bitmapNONE)
+			{
+				break;
+			}
+			if (bit >= BITMAP_STRESS_RESOURCES || stress_owner[bit] != OWNER_NONE)
+			{
+				bitmap_stress_errors[me]++;
+			}
+			stress_owner[bit] = (unsigned char) me;
+			held[count++] = bit;
+		}
+		bitmap_stress_allocs[me] += count;
+
+		for (i = 0; i < count; i++)
+		{
+			if (stress_owner[held[i]] != me)
+			{
+				bitmap_stress_errors[me]++;
+			}
+			stress_owner[held[i]] = OWNER_NONE;
+			memory_barrier();
+			FreeBitmap(&stress_alloc, held[i]);
+		}
+	}
+	bitmap_stress_cycles[me] = cycle_count() - start;
+}
@@ -0,0 +1,26 @@
+/**
+ * \file bitmap_example.h
+ * \brief Multi-core stress run of the bitmap allocator.
+ *
+ */
+
+
+#ifndef BITMAP_EXAMPLE_H_
+#define BITMAP_EXAMPLE_H_
+
+#include "bitmap_alloc.h"
+
+#define BITMAP_STRESS_RESOURCES 	40		// not a multiple of 32 on purpose
+#define BITMAP_STRESS_HOLD 			16		// resources held at once per core
+#define BITMAP_STRESS_ROUNDS 		100000
+
+extern volatile unsigned int bitmap_stress_errors[LOCKS_NUM_CORES];
+extern volatile unsigned int bitmap_stress_allocs[LOCKS_NUM_CORES];
+extern volatile unsigned int bitmap_stress_cycles[LOCKS_NUM_CORES];
+
+void BitmapStress(void);
+// to be called by all cores at the same time, on the host with
+// RunOnHostCores(BitmapStress, LOCKS_NUM_CORES). Every core repeatedly grabs
+// up to BITMAP_STRESS_HOLD resources and checks that nobody else owns them.
+
+#endif /* BITMAP_EXAMPLE_H_ */
@@ -0,0 +1,126 @@
+/**
+ * \file broadcast_example.c
+ * \brief Fan-out of ADC samples to 1, 2 and 3 consumers through a broadcast ring.
+ *
+ */
+
+#include "broadcast_example.h"
+
+#pragma section fardata "lmudata"
+adc_sample_t sample_slots[BROADCAST_RING_SIZE];
+broadcast_ring_t sample_ring;
+volatile unsigned int bench_round = 0;
+volatile unsigned int bench_done[LOCKS_NUM_CORES];
+volatile unsigned int broadcast_bench_cycles[LOCKS_NUM_CORES];
+volatile unsigned int broadcast_bench_errors[LOCKS_NUM_CORES];
+#pragma section fardata restore
+
+/* reads everything available, returns the number of samples consumed */
+static unsigned int consumeSamples(unsigned int consumer, unsigned int* expected)
+{
+	unsigned int available = AvailableBroadcast(&sample_ring, consumer);
+	unsigned int i;
+
+	if (available == 0)
+	{
+		__nop();
+		return 0;
+	}
+	memory_barrier();
+	for (i = 0; i < available; i++)
+	{
+		adc_sample_t* sample = BroadcastSlot(&sample_ring, *expected);
+		if (sample->sequence != *expected
+				|| sample->result[BROADCAST_ADC_CHANNELS - 1] != (unsigned short) *expected)
+		{
+			broadcast_bench_errors[core_id()]++;
+		}
+		(*expected)++;
+	}
+	ReleaseBroadcast(&sample_ring, consumer, available);
+	return available;
+}
+
+static void produceSamples(unsigned int own_consumer, boolean consume)
+{
+	unsigned int expected = 0;
+	unsigned int consumed = 0;
+	unsigned int sequence = 0;
+
+	while (sequence < BROADCAST_BENCH_SAMPLES)
+	{
+		adc_sample_t* sample = ClaimBroadcastSlot(&sample_ring);
+		if (sample != NULL)
+		{
+			int i;
+			sample->sequence = sequence;
+			for (i = 0; i < BROADCAST_ADC_CHANNELS; i++)
+			{
+				sample->result[i] = (unsigned short) sequence;
+			}
+			PublishBroadcastSlot(&sample_ring);
+			sequence++;
+		}
+		else if (!consume)
+		{
+			__nop();
+		}
+		if (consume)
+		{
+			consumed += consumeSamples(own_consumer, &expected);
+		}
+	}
+	while (consume && consumed < BROADCAST_BENCH_SAMPLES)
+	{
+		consumed += consumeSamples(own_consumer, &expected);
+	}
+}
+
+void BroadcastBenchmark(void)
+{
+	unsigned int me = core_id();
+	unsigned int consumer = (me + LOCKS_NUM_CORES - 1) % LOCKS_NUM_CORES;
+	unsigned int consumers;
+
+	for (consumers = 1; consumers <= LOCKS_NUM_CORES; consumers++)
+	{
+		if (me == 0)
+		{
+			unsigned int start;
+			unsigned int i;
+
+			InitBroadcastRing(&sample_ring, sample_slots, sizeof(adc_sample_t),
+					BROADCAST_RING_SIZE, consumers);
+			bench_round = consumers;
+
+			start = cycle_count();
+			produceSamples(consumer, consumer < consumers);
+			for (i = 1; i < LOCKS_NUM_CORES; i++)
+			{
+				while (bench_done[i] != consumers)
+				{
+					__nop();
+				}
+			}
+			broadcast_bench_cycles[consumers - 1] = cycle_count() - start;
+		}
+		else
+		{
+			while (bench_round != consumers)
+			{
+				__nop();
+			}
+			if (consumer < consumers)
+			{
+				unsigned int expected = 0;
+				unsigned int consumed = 0;
+				while (consumed < BROADCAST_BENCH_SAMPLES)
+				{
+					consumed += consumeSamples(consumer, &expected);
+				}
+			}
+			memory_barrier();
+			bench_done[me] = consumers;
+		}
+	}
+}
@@ -0,0 +1,33 @@
+/**
+ * \file broadcast_example.h
+ * \brief Fan-out of ADC samples to 1, 2 and 3 consumers through a broadcast ring.
+ *
+ */
+
+
+#ifndef BROADCAST_EXAMPLE_H_
+#define BROADCAST_EXAMPLE_H_
+
+#include "broadcast_ring.h"
+
+#define BROADCAST_RING_SIZE 		16
+#define BROADCAST_BENCH_SAMPLES 	10000
+#define BROADCAST_ADC_CHANNELS 		8
+
+typedef struct
+{
+	unsigned int sequence;
+	unsigned short result[BROADCAST_ADC_CHANNELS];
+} adc_sample_t;
+
+// cycles for BROADCAST_BENCH_SAMPLES samples to reach all consumers,
+// index 0..2 = 1..3 consumers
+extern volatile unsigned int broadcast_bench_cycles[LOCKS_NUM_CORES];
+extern volatile unsigned int broadcast_bench_errors[LOCKS_NUM_CORES];
+
+void BroadcastBenchmark(void);
+// to be called by all cores at the same time. Core 0 produces, consumer 0
+// runs on core 1, consumer 1 on core 2 and consumer 2 on core 0 between
+// the producer's publications.
+
+#endif /* BROADCAST_EXAMPLE_H_ */
@@ -0,0 +1,146 @@
+/**
+ * \file broadcast_ring.h
+ * \brief Wait-free single-producer multi-consumer broadcast ring.
+ *
+ */
+
+
+#ifndef BROADCAST_RING_H_
+#define BROADCAST_RING_H_
+
+#include "atomic_instructions.h"
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+// Every published slot is seen by every consumer, e.g. one ADC result set
+// that is filtered on core 1, logged on core 2 and limit checked on core 0.
+// The producer owns the head sequence, each consumer owns its own cursor;
+// both are only ever written by their owner, so neither side needs an atomic
+// instruction. Consumers read the slot in place, nothing is copied per
+// consumer. The producer only has to wait when the slowest consumer is a
+// full ring behind; it remembers the slowest cursor it saw and only scans
+// the cursors again when it catches up with that one.
+//
+// Sequences are free running 32 bit counters, the slot of a sequence is
+// seq & (size - 1), so size must be a power of two.
+
+#define BROADCAST_MAX_CONSUMERS 	4
+
+typedef struct broadcast_ring_t
+{
+	volatile unsigned int head;				// next sequence to publish
+	unsigned int gate;						// producer's copy of the slowest cursor
+	volatile unsigned int cursor[BROADCAST_MAX_CONSUMERS];	// next sequence to read
+	unsigned int num_consumers;
+	unsigned int mask;
+	unsigned int slot_size;
+	unsigned char* slots;
+} broadcast_ring_t;
+
+/**
+ * slots must hold size * slot_size bytes, size a power of two.
+ * Must be called before the producer or any consumer uses the ring.
+ */
+LOCK_INLINE void InitBroadcastRing(broadcast_ring_t* ring, void* slots,
+		unsigned int slot_size, unsigned int size, unsigned int num_consumers)
+{
+	unsigned int i;
+
+	ring->head = 0;
+	ring->gate = 0;
+	for (i = 0; i < BROADCAST_MAX_CONSUMERS; i++)
+	{
+		ring->cursor[i] = 0;
+	}
+	ring->num_consumers = num_consumers;
+	ring->mask = size - 1;
+	ring->slot_size = slot_size;
+	ring->slots = (unsigned char*) slots;
+	memory_barrier();
+}
+
+LOCK_INLINE void* BroadcastSlot(broadcast_ring_t* ring, unsigned int sequence)
+{
+	return ring->slots + (sequence & ring->mask) * ring->slot_size;
+}
+
+/**
+ * Producer: returns the slot to fill next, or NULL while the slowest
+ * consumer is still a full ring behind.
+ */
+LOCK_INLINE void* ClaimBroadcastSlot(broadcast_ring_t* ring)
+{
+	unsigned int head = ring->head;
+
+	if (head - ring->gate > ring->mask)
+	{
+		unsigned int slowest = head;
+		unsigned int i;
+
+		for (i = 0; i < ring->num_consumers; i++)
+		{
+			unsigned int cursor = ring->cursor[i];
+			if ((int) (cursor - slowest) < 0)
+			{
+				slowest = cursor;
+			}
+		}
+		ring->gate = slowest;
+		if (head - slowest > ring->mask)
+		{
+			return NULL;
+		}
+		// the consumers' reads of that slot are complete
+		memory_barrier();
+	}
+	return BroadcastSlot(ring, head);
+}
+
+/**
+ * Producer: makes the claimed slot visible to all consumers.
+ */
+LOCK_INLINE void PublishBroadcastSlot(broadcast_ring_t* ring)
+{
+	memory_barrier();
+	ring->head = ring->head + 1;
+}
+
+/**
+ * Consumer: number of published slots not yet read.
+ */
+LOCK_INLINE unsigned int AvailableBroadcast(broadcast_ring_t* ring,
+		unsigned int consumer)
+{
+	return ring->head - ring->cursor[consumer];
+}
+
+/**
+ * Consumer: the oldest unread slot, or NULL when there is none. The slot
+ * stays valid until it is released.
+ */
+LOCK_INLINE void* PeekBroadcast(broadcast_ring_t* ring, unsigned int consumer)
+{
+	unsigned int cursor = ring->cursor[consumer];
+
+	if (cursor == ring->head)
+	{
+		return NULL;
+	}
+	memory_barrier();
+	return BroadcastSlot(ring, cursor);
+}
+
+/**
+ * Consumer: hands count slots back to the producer, batched releases
+ * reduce the traffic on the shared cursor.
+ */
+LOCK_INLINE void ReleaseBroadcast(broadcast_ring_t* ring, unsigned int consumer,
+		unsigned int count)
+{
+	memory_barrier();
+	ring->cursor[consumer] = ring->cursor[consumer] + count;
+}
+
+#endif /* BROADCAST_RING_H_ */
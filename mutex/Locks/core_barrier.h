@@ -0,0 +1,146 @@
+/**
+ * \file core_barrier.h
+ * \brief Reusable barriers for any number of cores.
+ *
+ */
+
+
+#ifndef CORE_BARRIER_H_
+#define CORE_BARRIER_H_
+
+#include "atomic_instructions.h"
+
+// Centralized sense-reversing barrier: every core increments one counter,
+// the last one to arrive resets it and flips the global sense the others
+// spin on. Each episode uses the opposite sense of the previous one, so the
+// barrier can be passed back-to-back without a second handshake.
+// O(n) atomic increments on one word, a single shared flag to spin on.
+//
+// It is split-phase: ArriveAtCoreBarrier() only announces the core and
+// returns at once, WaitAtCoreBarrier() blocks until everybody has arrived.
+// Work that does not depend on the other cores can be placed in between.
+
+typedef struct corebarrier_t
+{
+	unsigned int count;
+	volatile unsigned int sense;
+	unsigned int num_cores;
+	volatile unsigned int local_sense[LOCKS_NUM_CORES];
+} corebarrier_t;
+
+#define COREBARRIER_INIT(cores) { .count = 0, .sense = 0, .num_cores = (cores) }
+
+LOCK_INLINE unsigned int ArriveAtCoreBarrier(corebarrier_t* b)
+{
+	unsigned int me = core_id();
+	unsigned int my_sense = !b->local_sense[me];
+
+	b->local_sense[me] = my_sense;
+	memory_barrier();
+	if (swap_incr(&b->count) == b->num_cores - 1)
+	{
+		// last one: nobody touches count until the sense flips
+		b->count = 0;
+		memory_barrier();
+		b->sense = my_sense;
+	}
+	return my_sense;
+}
+
+LOCK_INLINE boolean IsCoreBarrierDone(corebarrier_t* b, unsigned int token)
+{
+	return b->sense == token;
+}
+
+LOCK_INLINE void WaitAtCoreBarrier(corebarrier_t* b, unsigned int token)
+{
+	while (b->sense != token)
+	{
+		__nop();
+	}
+	memory_barrier();
+}
+
+LOCK_INLINE void PassCoreBarrier(corebarrier_t* b)
+{
+	WaitAtCoreBarrier(b, ArriveAtCoreBarrier(b));
+}
+
+
+// Dissemination barrier: in round r core i signals core (i + 2^r) mod n and
+// waits for the signal of core (i - 2^r) mod n. After ceil(log2 n) rounds
+// every core has transitively heard from every other one. No atomic
+// instruction at all and every core spins on flags in its own node, which
+// should be placed in the core's DSPR (see barrier_example.c). Parity and
+// sense make the flags reusable without resetting them.
+
+#define DISSEMINATION_MAX_ROUNDS 4		// up to 16 cores
+
+typedef struct dissemination_node_t
+{
+	volatile unsigned int flags[2][DISSEMINATION_MAX_ROUNDS];
+	unsigned int parity;
+	unsigned int sense;
+} dissemination_node_t;
+
+typedef struct dissemination_barrier_t
+{
+	dissemination_node_t** node;	// one per core, indexed by core id
+	unsigned int num_cores;
+	unsigned int rounds;
+} dissemination_barrier_t;
+
+/**
+ * Must be called before any core enters the barrier.
+ */
+LOCK_INLINE void InitDisseminationBarrier(dissemination_barrier_t* b,
+		dissemination_node_t** node, unsigned int num_cores)
+{
+	unsigned int i, r;
+
+	b->node = node;
+	b->num_cores = num_cores;
+	for (b->rounds = 0; (1u << b->rounds) < num_cores; b->rounds++)
+		;
+	for (i = 0; i < num_cores; i++)
+	{
+		node[i]->parity = 0;
+		node[i]->sense = 1;
+		for (r = 0; r < DISSEMINATION_MAX_ROUNDS; r++)
+		{
+			node[i]->flags[0][r] = 0;
+			node[i]->flags[1][r] = 0;
+		}
+	}
+	memory_barrier();
+}
+
+LOCK_INLINE void PassDisseminationBarrier(dissemination_barrier_t* b)
+{
+	unsigned int me = core_id();
+	dissemination_node_t* mine = b->node[me];
+	unsigned int parity = mine->parity;
+	unsigned int sense = mine->sense;
+	unsigned int r;
+
+	memory_barrier();
+	for (r = 0; r < b->rounds; r++)
+	{
+		unsigned int partner = (me + (1u << r)) % b->num_cores;
+
+		b->node[partner]->flags[parity][r] = sense;
+		while (mine->flags[parity][r] != sense)
+		{
+			__nop();
+		}
+	}
+	memory_barrier();
+
+	if (parity == 1)
+	{
+		mine->sense = !sense;
+	}
+	mine->parity = 1 - parity;
+}
+
+#endif /* CORE_BARRIER_H_ */
@@ -0,0 +1,89 @@
+/**
+ * \file counting_semaphore.h
+ * \brief Counting semaphore for cross-core producer/consumer.
+ *
+ */
+
+
+#ifndef COUNTING_SEMAPHORE_H_
+#define COUNTING_SEMAPHORE_H_
+
+#include "sync_wait.h"
+
+// The count is changed with compare and swap only, so posting is lock-free
+// and may be done from any core and from ISRs. Taking may also be tried
+// from an ISR, but only task level code should block in TakeSemaphore().
+// A consumer can take several units at once, e.g. wait until N items of a
+// ring buffer are ready.
+
+typedef struct semaphore_t
+{
+	unsigned int count;
+} semaphore_t;
+
+#define SEMAPHORE_INIT(initial) { .count = (initial) }
+
+/**
+ * Adds n units and releases the waiters they satisfy. ISR-safe.
+ */
+LOCK_INLINE void PostSemaphore(semaphore_t* s, unsigned int n)
+{
+	memory_barrier();
+	swap_add(&s->count, n);
+}
+
+LOCK_INLINE boolean TryToTakeSemaphore(semaphore_t* s, unsigned int n)
+{
+	unsigned int count = *(volatile unsigned int*) &s->count;
+
+	while (count >= n)
+	{
+		if (cmp_swap(&s->count, count, count - n))
+		{
+			memory_barrier();
+			return TRUE;
+		}
+		count = *(volatile unsigned int*) &s->count;
+	}
+	return FALSE;
+}
+
+/**
+ * Blocks until n units are available and takes them.
+ */
+LOCK_INLINE void TakeSemaphore(semaphore_t* s, unsigned int n)
+{
+	syncwait_t w = SYNCWAIT_INIT;
+
+	while (!TryToTakeSemaphore(s, n))
+	{
+		SyncWait(&w);
+	}
+}
+
+/**
+ * Like TakeSemaphore(), but gives up after timeout cycles.
+ */
+LOCK_INLINE boolean TakeSemaphoreTimeout(semaphore_t* s, unsigned int n,
+		unsigned int timeout)
+{
+	syncwait_t w = SYNCWAIT_INIT;
+	unsigned int start = cycle_count();
+
+	while (!TryToTakeSemaphore(s, n))
+	{
+		if (cycle_count() - start >= timeout)
+		{
+			return FALSE;
+		}
+		SyncWait(&w);
+	}
+	return TRUE;
+}
+
+LOCK_INLINE unsigned int GetSemaphoreCount(semaphore_t* s)
+{
+	return *(volatile unsigned int*) &s->count;
+}
+
+#endif /* COUNTING_SEMAPHORE_H_ */
@@ -0,0 +1,88 @@
+/**
+ * \file event_flags.h
+ * \brief Event-flag groups for cross-core signalling.
+ *
+ */
+
+
+#ifndef EVENT_FLAGS_H_
+#define EVENT_FLAGS_H_
+
+#include "sync_wait.h"
+
+// Up to 32 events in one word. Setting and clearing are single swap_msk
+// operations, lock-free and ISR-safe. A waiter blocks until all or any of
+// the events in its mask are set and can consume exactly those events
+// atomically, so two consumers never both see the same event.
+
+#define eventflagsWAIT_ANY 		0
+#define eventflagsWAIT_ALL 		1
+
+typedef struct eventflags_t
+{
+	unsigned int flags;
+} eventflags_t;
+
+#define EVENTFLAGS_INIT { .flags = 0 }
+
+/* ISR-safe */
+LOCK_INLINE void SetEventFlags(eventflags_t* e, unsigned int mask)
+{
+	memory_barrier();
+	swap_msk(&e->flags, mask, mask);
+}
+
+/* ISR-safe */
+LOCK_INLINE void ClearEventFlags(eventflags_t* e, unsigned int mask)
+{
+	swap_msk(&e->flags, mask, 0);
+}
+
+LOCK_INLINE unsigned int GetEventFlags(eventflags_t* e)
+{
+	return *(volatile unsigned int*) &e->flags;
+}
+
+/**
+ * Returns the events of mask that satisfied the wait condition, 0 if it is
+ * not met. With consume the returned events are cleared atomically.
+ */
+LOCK_INLINE unsigned int TryToWaitEventFlags(eventflags_t* e, unsigned int mask,
+		unsigned int mode, boolean consume)
+{
+	unsigned int flags = GetEventFlags(e);
+
+	while (1)
+	{
+		unsigned int hit = flags & mask;
+
+		if (hit == 0 || (mode == eventflagsWAIT_ALL && hit != mask))
+		{
+			return 0;
+		}
+		if (!consume || cmp_swap(&e->flags, flags, flags & ~hit))
+		{
+			memory_barrier();
+			return hit;
+		}
+		flags = GetEventFlags(e);
+	}
+}
+
+/**
+ * Blocks until the events are set, see TryToWaitEventFlags().
+ */
+LOCK_INLINE unsigned int WaitEventFlags(eventflags_t* e, unsigned int mask,
+		unsigned int mode, boolean consume)
+{
+	syncwait_t w = SYNCWAIT_INIT;
+	unsigned int hit;
+
+	while ((hit = TryToWaitEventFlags(e, mask, mode, consume)) == 0)
+	{
+		SyncWait(&w);
+	}
+	return hit;
+}
+
+#endif /* EVENT_FLAGS_H_ */
@@ -0,0 +1,160 @@
+/**
+ * \file freelist.h
+ * \brief ABA-safe lock-free free-list (Treiber stack) and object pool.
+ *
+ */
+
+
+#ifndef FREELIST_H_
+#define FREELIST_H_
+
+#include "atomic_instructions.h"
+
+#ifndef NULL
+#define NULL 0
+#endif
+
+// __cmpswapw only covers 32 bits, so a pointer based Treiber stack can not
+// carry a version counter next to the pointer and suffers from ABA.
+// Instead the nodes are addressed by a 16 bit index into a static pool and
+// the head word holds the index of the top node in its lower half and a
+// version tag in its upper half. The tag is incremented with every update,
+// so a pop that read a stale head fails even if the same index has been
+// popped and pushed back in the meantime. The tag only wraps after 65536
+// updates during a single pop, which can not happen on AURIX in practice.
+
+#define freelistEMPTY 			0xFFFFu
+#define FREELIST_MAX_NODES 		0xFFFFu
+
+#define FREELIST_INDEX(head) 	((head) & 0xFFFFu)
+#define FREELIST_TAG(head) 		((head) & 0xFFFF0000u)
+#define FREELIST_HEAD(head, index) \
+	((FREELIST_TAG(head) + 0x10000u) | (index))
+
+typedef struct freelist_t
+{
+	volatile unsigned int head;			// tag << 16 | index of the top node
+	volatile unsigned short* next;		// link of every node, same index as the pool
+	unsigned short size;
+} freelist_t;
+
+/**
+ * Links count nodes, all of them free when filled is TRUE.
+ * Must be called before any other core or ISR uses the list.
+ */
+LOCK_INLINE void InitFreeList(freelist_t* list, unsigned short* next,
+		unsigned short count, boolean filled)
+{
+	unsigned short i;
+
+	for (i = 0; i < count; i++)
+	{
+		next[i] = (i + 1 < count) ? (unsigned short) (i + 1) : freelistEMPTY;
+	}
+
+	list->next = next;
+	list->size = count;
+	list->head = (filled && count > 0) ? 0 : freelistEMPTY;
+	barrier();
+}
+
+/**
+ * Removes the top node and returns its index, or freelistEMPTY.
+ * Lock-free, may be used from any core and from ISRs.
+ */
+LOCK_INLINE unsigned int PopFreeList(freelist_t* list)
+{
+	unsigned int old_head;
+	unsigned int index;
+	unsigned int next;
+
+	do
+	{
+		old_head = list->head;
+		index = FREELIST_INDEX(old_head);
+		if (index == freelistEMPTY)
+		{
+			return freelistEMPTY;
+		}
+		// may read a link that is being rewritten by its new owner,
+		// in that case the tag has changed and the swap below fails
+		next = list->next[index];
+	} while (!cmp_swap((unsigned int*) &list->head, old_head,
+			FREELIST_HEAD(old_head, next)));
+
+	return index;
+}
+
+/**
+ * Puts node index back on top of the list.
+ * Lock-free, may be used from any core and from ISRs.
+ */
+LOCK_INLINE void PushFreeList(freelist_t* list, unsigned int index)
+{
+	unsigned int old_head;
+
+	do
+	{
+		old_head = list->head;
+		list->next[index] = (unsigned short) FREELIST_INDEX(old_head);
+		barrier();
+	} while (!cmp_swap((unsigned int*) &list->head, old_head,
+			FREELIST_HEAD(old_head, index)));
+}
+
+LOCK_INLINE boolean IsFreeListEmpty(freelist_t* list)
+{
+	return FREELIST_INDEX(list->head) == freelistEMPTY;
+}
+
+
+// Fixed size object pool on top of the free-list, e.g. for CAN messages or
+// DMA descriptors. Allocation and free are O(1) and do not take any lock.
+//
+//   OBJPOOL_DEFINE(canMsgPool, IfxCan_Message, 32);
+//   InitObjPool(&canMsgPool, canMsgPool_objects, sizeof(IfxCan_Message),
+//               canMsgPool_next, 32);
+//   IfxCan_Message* msg = AllocPoolObject(&canMsgPool);
+//   FreePoolObject(&canMsgPool, msg);
+//
+// Place the definition with #pragma section fardata "lmudata" when the pool
+// is shared by several cores.
+
+typedef struct objpool_t
+{
+	freelist_t list;
+	unsigned char* objects;
+	unsigned int object_size;
+} objpool_t;
+
+#define OBJPOOL_DEFINE(name, type, count) \
+	type name##_objects[count]; \
+	unsigned short name##_next[count]; \
+	objpool_t name
+
+LOCK_INLINE void InitObjPool(objpool_t* pool, void* objects,
+		unsigned int object_size, unsigned short* next, unsigned short count)
+{
+	pool->objects = (unsigned char*) objects;
+	pool->object_size = object_size;
+	InitFreeList(&pool->list, next, count, TRUE);
+}
+
+LOCK_INLINE void* AllocPoolObject(objpool_t* pool)
+{
+	unsigned int index = PopFreeList(&pool->list);
+	if (index == freelistEMPTY)
+	{
+		return NULL;
+	}
+	return pool->objects + index * pool->object_size;
+}
+
+LOCK_INLINE void FreePoolObject(objpool_t* pool, void* object)
+{
+	unsigned int index = (unsigned int) ((unsigned char*) object - pool->objects)
+			/ pool->object_size;
+	PushFreeList(&pool->list, index);
+}
+
+#endif /* FREELIST_H_ */
@@ -0,0 +1,58 @@
+/**
+ * \file host_port.c
+ * \brief Host (Linux, gcc/clang) emulation of the TriCore intrinsics used by the Locks package.
+ *
+ */
+
+#include "atomic_instructions.h"
+
+#if LOCKS_HOST
+
+#include <time.h>
+
+__thread unsigned int locks_host_core_id = 0;
+
+typedef struct
+{
+	void (*core_main)(void);
+	unsigned int core;
+} host_core_t;
+
+unsigned int host_cycle_count(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned int) ((unsigned long long) now.tv_sec * 1000000000ull + now.tv_nsec);
+}
+
+static void* hostCoreEntry(void* arg)
+{
+	host_core_t* core = (host_core_t*) arg;
+	locks_host_core_id = core->core;
+	core->core_main();
+	return 0;
+}
+
+void RunOnHostCores(void (*core_main)(void), unsigned int cores)
+{
+	pthread_t thread[LOCKS_NUM_CORES];
+	host_core_t core[LOCKS_NUM_CORES];
+	unsigned int i;
+
+	if (cores > LOCKS_NUM_CORES)
+	{
+		cores = LOCKS_NUM_CORES;
+	}
+	for (i = 0; i < cores; i++)
+	{
+		core[i].core_main = core_main;
+		core[i].core = i;
+		pthread_create(&thread[i], 0, hostCoreEntry, &core[i]);
+	}
+	for (i = 0; i < cores; i++)
+	{
+		pthread_join(thread[i], 0);
+	}
+}
+
+#endif /* LOCKS_HOST */
@@ -0,0 +1,90 @@
+/**
+ * \file host_port.h
+ * \brief Host (Linux, gcc/clang) emulation of the TriCore intrinsics used by the Locks package.
+ *
+ */
+
+
+#ifndef HOST_PORT_H_
+#define HOST_PORT_H_
+
+// Selected with -DLOCKS_HOST=1. Every "core" is a pthread; its core id is
+// set by RunOnHostCores(). The atomic intrinsics are mapped onto the gcc
+// __atomic builtins with sequential consistency, which is at least as strong
+// as the ordering the TriCore instructions give.
+
+#include <pthread.h>
+#include <sched.h>
+
+typedef unsigned char boolean;
+typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned int uint32;
+typedef unsigned long long uint64;
+typedef signed char sint8;
+typedef signed short sint16;
+typedef signed int sint32;
+typedef signed long long sint64;
+
+#ifndef TRUE
+#define TRUE 	1
+#endif
+#ifndef FALSE
+#define FALSE 	0
+#endif
+
+/* __nop() only appears in spin loops, let the other emulated cores run */
+#define __nop() 	sched_yield()
+#define __dsync() 	__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+extern __thread unsigned int locks_host_core_id;
+
+unsigned int host_cycle_count(void);
+
+static inline unsigned int __mfcr(unsigned int reg)
+{
+	return (reg == 0xFE1C) ? locks_host_core_id : host_cycle_count();
+}
+
+/* the only register written is CCTRL, the host counter always runs */
+static inline void __mtcr(unsigned int reg, unsigned int value)
+{
+	(void) reg;
+	(void) value;
+}
+
+#define __isync()
+
+static inline unsigned int __cmpswapw(unsigned int* address,
+		unsigned int value, unsigned int condition)
+{
+	__atomic_compare_exchange_n(address, &condition, value, 0,
+			__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return condition;
+}
+
+static inline unsigned int __swap(unsigned int* address, unsigned int value)
+{
+	return __atomic_exchange_n(address, value, __ATOMIC_SEQ_CST);
+}
+
+static inline unsigned int __swapmskw(unsigned int* address,
+		unsigned int value, unsigned int mask)
+{
+	unsigned int old_value = *address;
+	while (!__atomic_compare_exchange_n(address, &old_value,
+			(old_value & ~mask) | (value & mask), 0,
+			__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+		;
+	return old_value;
+}
+
+static inline unsigned int __clz(unsigned int value)
+{
+	return value ? (unsigned int) __builtin_clz(value) : 32;
+}
+
+/* runs core_main on cores pthreads with core ids 0..cores-1 and joins them */
+void RunOnHostCores(void (*core_main)(void), unsigned int cores);
+
+#endif /* HOST_PORT_H_ */
@@ -107,24 +107,13 @@ void ReleaseLock(void)
 
 mcslock_t *current_tail = NULL;
 
-#pragma section fardata "data_cpu0"
-mcslock_t core_lock_0;
-#pragma section fardata restore
-
-#pragma section fardata "data_cpu1"
-mcslock_t core_lock_1;
-#pragma section fardata restore
-
-#pragma section fardata "data_cpu2"
-mcslock_t core_lock_2;
-#pragma section fardata restore
+#include "per_core.h"
 
-mcslock_t* core_lock[3] = { &core_lock_0, &core_lock_1, &core_lock_2 };
+PER_CORE(mcslock_t, core_lock);
 
 mcslock_t* my_lock(void)
 {
-	int id = getCoreId();
-	return core_lock[id];
+	return &PER_CORE_THIS(core_lock);
 }
 
 boolean TryToGetLock(void)
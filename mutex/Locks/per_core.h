@@ -0,0 +1,80 @@
+/**
+ * \file per_core.h
+ * \brief Per-core variables in the local DSPR of every core, with a padded shared fallback.
+ *
+ */
+
+
+#ifndef PER_CORE_H_
+#define PER_CORE_H_
+
+#include "atomic_instructions.h"
+
+// PER_CORE(type, name) defines one instance of the variable per core, each in
+// the DSPR of its core, instead of an array indexed by getCoreId() in one
+// memory. Accesses of a core to its own instance stay in its local scratchpad:
+// no SRI bus transaction, no contention with the other cores and no cache
+// line shared with their instances.
+//
+//   PER_CORE(mcslock_t, core_lock);            // in a .c file
+//   PER_CORE_DECLARE(mcslock_t, core_lock);    // in a header, if needed
+//
+//   PER_CORE_THIS(core_lock).next = NULL;      // instance of the calling core
+//   PER_CORE_ON(core_lock, 2).locked = 1;      // instance of core 2
+//
+// PER_CORE_SHARED(type, name) has the same accessors but places all instances
+// in the LMU, each padded and aligned to a cache line of LOCKS_CACHE_LINE
+// bytes. Use it when the data has to live in a shared memory, e.g. as DMA
+// target. Instances packed next to each other would share cache lines: since
+// the data caches of the cores are not coherent, a core writing back its line
+// could overwrite the instance of another core, and even uncached they share
+// an LMU bank and its access slots.
+//
+// Only LOCKS_NUM_CORES == 3 is spelled out below.
+
+#ifndef LOCKS_CACHE_LINE
+#define LOCKS_CACHE_LINE 32		/* data cache line of the TC3xx cores */
+#endif
+
+#if defined(__TASKING__)
+#define LOCKS_ALIGNED(n) __align(n)
+#else
+#define LOCKS_ALIGNED(n) __attribute__((aligned(n)))
+#endif
+
+/* size of type rounded up to whole cache lines */
+#define PER_CORE_PADDED_SIZE(type) \
+	(((sizeof(type) + LOCKS_CACHE_LINE - 1) / LOCKS_CACHE_LINE) * LOCKS_CACHE_LINE)
+
+#define PER_CORE(type, name) \
+	_Pragma("section fardata \"data_cpu0\"") \
+	type name##_cpu0; \
+	_Pragma("section fardata restore") \
+	_Pragma("section fardata \"data_cpu1\"") \
+	type name##_cpu1; \
+	_Pragma("section fardata restore") \
+	_Pragma("section fardata \"data_cpu2\"") \
+	type name##_cpu2; \
+	_Pragma("section fardata restore") \
+	type* const name##_of[LOCKS_NUM_CORES] = { &name##_cpu0, &name##_cpu1, &name##_cpu2 }
+
+#define PER_CORE_SHARED(type, name) \
+	_Pragma("section fardata \"lmudata\"") \
+	LOCKS_ALIGNED(LOCKS_CACHE_LINE) union \
+	{ \
+		type value; \
+		unsigned char line[PER_CORE_PADDED_SIZE(type)]; \
+	} name##_slot[LOCKS_NUM_CORES]; \
+	_Pragma("section fardata restore") \
+	type* const name##_of[LOCKS_NUM_CORES] = { &name##_slot[0].value, &name##_slot[1].value, &name##_slot[2].value }
+
+#define PER_CORE_DECLARE(type, name) \
+	extern type* const name##_of[LOCKS_NUM_CORES]
+
+/* instance of the given core */
+#define PER_CORE_ON(name, core) 	(*name##_of[(core)])
+
+/* instance of the calling core */
+#define PER_CORE_THIS(name) 		(*name##_of[core_id()])
+
+#endif /* PER_CORE_H_ */
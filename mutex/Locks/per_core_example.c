@@ -0,0 +1,45 @@
+/**
+ * \file per_core_example.c
+ * \brief False sharing benchmark: packed, padded and DSPR placed per-core counters.
+ *
+ */
+
+
+#include "per_core_example.h"
+#include "core_barrier.h"
+
+#pragma section fardata "lmudata"
+volatile unsigned int packed_counter[LOCKS_NUM_CORES];
+volatile unsigned int per_core_bench[PER_CORE_BENCH_LAYOUTS][LOCKS_NUM_CORES];
+corebarrier_t per_core_bench_barrier = COREBARRIER_INIT(LOCKS_NUM_CORES);
+#pragma section fardata restore
+
+PER_CORE_SHARED(volatile unsigned int, padded_counter);
+PER_CORE(volatile unsigned int, local_counter);
+
+static unsigned int CountUp(volatile unsigned int* counter)
+{
+	unsigned int start;
+	int i;
+
+	*counter = 0;
+	PassCoreBarrier(&per_core_bench_barrier);
+
+	start = cycle_count();
+	for (i = 0; i < PER_CORE_BENCH_ITERATIONS; i++)
+	{
+		(*counter)++;
+	}
+	return cycle_count() - start;
+}
+
+void FalseSharingBenchmark(void)
+{
+	unsigned int core = core_id();
+
+	per_core_bench[0][core] = CountUp(&packed_counter[core]);
+	per_core_bench[1][core] = CountUp(&PER_CORE_THIS(padded_counter));
+	per_core_bench[2][core] = CountUp(&PER_CORE_THIS(local_counter));
+
+	PassCoreBarrier(&per_core_bench_barrier);
+}
@@ -0,0 +1,26 @@
+/**
+ * \file per_core_example.h
+ * \brief False sharing benchmark: packed, padded and DSPR placed per-core counters.
+ *
+ */
+
+
+#ifndef PER_CORE_EXAMPLE_H_
+#define PER_CORE_EXAMPLE_H_
+
+#include "per_core.h"
+
+#define PER_CORE_BENCH_ITERATIONS 10000
+
+// cycles per PER_CORE_BENCH_ITERATIONS increments of the own counter, all
+// cores counting at the same time, per core and layout:
+//   0: unsigned int[3] in the LMU, as with indexing by getCoreId()
+//   1: PER_CORE_SHARED, one cache line per core in the LMU
+//   2: PER_CORE, in the local DSPR
+#define PER_CORE_BENCH_LAYOUTS 3
+extern volatile unsigned int per_core_bench[PER_CORE_BENCH_LAYOUTS][LOCKS_NUM_CORES];
+
+void FalseSharingBenchmark(void);
+// to be called by all cores at the same time, e.g. after synchronizeOtherCores()
+
+#endif /* PER_CORE_EXAMPLE_H_ */
@@ -0,0 +1,119 @@
+/**
+ * \file rcu.h
+ * \brief Epoch based read-copy-update for shared configuration tables.
+ *
+ */
+
+
+#ifndef RCU_H_
+#define RCU_H_
+
+#include "atomic_instructions.h"
+
+// Readers announce the global epoch they entered with in their own slot and
+// clear it when they leave; no atomic instruction is needed on the read
+// side. A writer publishes a new version with RcuAssignPointer(), advances
+// the epoch and waits until no core is still inside a read section that
+// started before the advance. After that grace period nobody can hold a
+// reference to the old version and it may be reused.
+//
+// Read sections may nest (also an ISR interrupting a reader on the same
+// core) but must not block. Writers of the same rcu_t have to be serialized,
+// e.g. by updating from one core only or by holding GetLock(). A writer
+// must not wait for a grace period from an ISR that may have interrupted a
+// reader on its own core.
+
+typedef struct rcu_t
+{
+	volatile unsigned int epoch;
+	volatile unsigned int reader_epoch[LOCKS_NUM_CORES];	// 0: not reading
+	volatile unsigned int nesting[LOCKS_NUM_CORES];
+} rcu_t;
+
+#define RCU_INIT { .epoch = 1 }
+
+#define RcuDereference(pointer) (*(void* volatile*) &(pointer))
+
+#define RcuAssignPointer(pointer, value) \
+	do { memory_barrier(); (pointer) = (value); memory_barrier(); } while (0)
+
+LOCK_INLINE void RcuReadLock(rcu_t* rcu)
+{
+	unsigned int me = core_id();
+	unsigned int nesting = rcu->nesting[me];
+
+	rcu->nesting[me] = nesting + 1;
+	if (nesting == 0)
+	{
+		rcu->reader_epoch[me] = rcu->epoch;
+		// the announcement must be visible before the protected pointer is read
+		memory_barrier();
+	}
+	barrier();
+}
+
+LOCK_INLINE void RcuReadUnlock(rcu_t* rcu)
+{
+	unsigned int me = core_id();
+	unsigned int nesting = rcu->nesting[me] - 1;
+
+	barrier();
+	if (nesting == 0)
+	{
+		memory_barrier();
+		rcu->reader_epoch[me] = 0;
+	}
+	rcu->nesting[me] = nesting;
+}
+
+/**
+ * Starts a grace period after a new version has been published.
+ * Returns the token for IsRcuGracePeriodOver().
+ */
+LOCK_INLINE unsigned int StartRcuGracePeriod(rcu_t* rcu)
+{
+	unsigned int token = rcu->epoch + 1;
+
+	memory_barrier();
+	rcu->epoch = token;
+	memory_barrier();
+	return token;
+}
+
+/**
+ * TRUE once every reader that may still see the version replaced before
+ * StartRcuGracePeriod() has left its read section. Never blocks.
+ */
+LOCK_INLINE boolean IsRcuGracePeriodOver(rcu_t* rcu, unsigned int token)
+{
+	unsigned int me = core_id();
+	unsigned int i;
+
+	for (i = 0; i < LOCKS_NUM_CORES; i++)
+	{
+		unsigned int reader = rcu->reader_epoch[i];
+		if (i == me || reader == 0)
+		{
+			continue;
+		}
+		if ((int) (reader - token) < 0)
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/**
+ * Waits for a full grace period. Must not be called inside a read section.
+ */
+LOCK_INLINE void SynchronizeRcu(rcu_t* rcu)
+{
+	unsigned int token = StartRcuGracePeriod(rcu);
+	while (!IsRcuGracePeriodOver(rcu, token))
+	{
+		__nop();
+	}
+}
+
+#endif /* RCU_H_ */
@@ -0,0 +1,87 @@
+/**
+ * \file rcu_example.c
+ * \brief Hot swap of a lookup table that other cores read in a tight loop.
+ *
+ */
+
+#include "rcu_example.h"
+
+#pragma section fardata "lmudata"
+rcu_t table_rcu = RCU_INIT;
+calibration_table_t table_storage[2];
+calibration_table_t* current_table = 0;
+volatile unsigned int rcu_readers_started = 0;
+volatile unsigned int rcu_writer_done = 0;
+volatile unsigned int rcu_reads[LOCKS_NUM_CORES];
+volatile unsigned int rcu_torn_reads[LOCKS_NUM_CORES];
+volatile unsigned int rcu_grace_cycles = 0;
+#pragma section fardata restore
+
+static void fillTable(calibration_table_t* table, unsigned int version)
+{
+	int i;
+	table->version = version;
+	for (i = 0; i < RCU_TABLE_SIZE; i++)
+	{
+		table->value[i] = (unsigned short) (version + i);
+	}
+}
+
+void RcuTableWriter(void)
+{
+	calibration_table_t* spare = &table_storage[1];
+	unsigned int version;
+	unsigned int start;
+
+	fillTable(&table_storage[0], 0);
+	RcuAssignPointer(current_table, &table_storage[0]);
+
+	// the swaps only show something if the readers are already in their loop
+	while (rcu_readers_started < LOCKS_NUM_CORES - 1)
+	{
+	}
+
+	for (version = 1; version <= RCU_SWAPS; version++)
+	{
+		calibration_table_t* old = current_table;
+
+		// nobody references the spare table anymore, rewrite it in place
+		fillTable(spare, version);
+		RcuAssignPointer(current_table, spare);
+
+		start = cycle_count();
+		SynchronizeRcu(&table_rcu);
+		rcu_grace_cycles += cycle_count() - start;
+
+		spare = old;
+	}
+
+	rcu_writer_done = 1;
+}
+
+void RcuTableReader(void)
+{
+	unsigned int me = core_id();
+
+	swap_incr((unsigned int*) &rcu_readers_started);
+	while (!rcu_writer_done)
+	{
+		calibration_table_t* table;
+		int i;
+
+		RcuReadLock(&table_rcu);
+		table = RcuDereference(current_table);
+		for (i = 0; table != 0 && i < RCU_TABLE_SIZE; i++)
+		{
+			// a table that was rewritten while we read it would show up here
+			if (table->value[i] != (unsigned short) (table->version + i))
+			{
+				rcu_torn_reads[me]++;
+				break;
+			}
+		}
+		RcuReadUnlock(&table_rcu);
+
+		rcu_reads[me]++;
+	}
+}
@@ -0,0 +1,31 @@
+/**
+ * \file rcu_example.h
+ * \brief Hot swap of a lookup table that other cores read in a tight loop.
+ *
+ */
+
+
+#ifndef RCU_EXAMPLE_H_
+#define RCU_EXAMPLE_H_
+
+#include "rcu.h"
+
+#define RCU_TABLE_SIZE 	64
+#define RCU_SWAPS 		1000
+
+typedef struct
+{
+	unsigned int version;
+	unsigned short value[RCU_TABLE_SIZE];
+} calibration_table_t;
+
+extern volatile unsigned int rcu_reads[LOCKS_NUM_CORES];
+extern volatile unsigned int rcu_torn_reads[LOCKS_NUM_CORES];
+
+void RcuTableWriter(void);
+// publishes RCU_SWAPS new table versions, call it on one core (e.g. core 0)
+
+void RcuTableReader(void);
+// reads the table until the writer is done, call it on the other cores
+
+#endif /* RCU_EXAMPLE_H_ */
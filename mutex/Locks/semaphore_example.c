@@ -0,0 +1,61 @@
+/**
+ * \file semaphore_example.c
+ * \brief Bounded producer/consumer between cores with semaphores and event flags.
+ *
+ */
+
+#include "semaphore_example.h"
+
+#pragma section fardata "lmudata"
+unsigned int item_queue[ITEM_QUEUE_SIZE];
+semaphore_t items_ready = SEMAPHORE_INIT(0);
+semaphore_t slots_free = SEMAPHORE_INIT(ITEM_QUEUE_SIZE);
+eventflags_t item_events = EVENTFLAGS_INIT;
+volatile unsigned int items_consumed = 0;
+volatile unsigned int items_out_of_order = 0;
+volatile unsigned int items_cycles = 0;
+#pragma section fardata restore
+
+void ItemProducer(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < ITEM_COUNT; i++)
+	{
+		TakeSemaphore(&slots_free, 1);
+		item_queue[i % ITEM_QUEUE_SIZE] = i;
+		PostSemaphore(&items_ready, 1);
+	}
+	SetEventFlags(&item_events, EVENT_PRODUCER_DONE);
+}
+
+void ItemConsumer(void)
+{
+	unsigned int next = 0;
+
+	while (next < ITEM_COUNT)
+	{
+		int i;
+
+		TakeSemaphore(&items_ready, ITEM_BATCH);
+		for (i = 0; i < ITEM_BATCH; i++, next++)
+		{
+			if (item_queue[next % ITEM_QUEUE_SIZE] != next)
+			{
+				items_out_of_order++;
+			}
+		}
+		items_consumed = next;
+		PostSemaphore(&slots_free, ITEM_BATCH);
+	}
+	SetEventFlags(&item_events, EVENT_CONSUMER_DONE);
+}
+
+void ItemMonitor(void)
+{
+	unsigned int start = cycle_count();
+
+	WaitEventFlags(&item_events, EVENT_PRODUCER_DONE | EVENT_CONSUMER_DONE,
+			eventflagsWAIT_ALL, TRUE);
+	items_cycles = cycle_count() - start;
+}
@@ -0,0 +1,34 @@
+/**
+ * \file semaphore_example.h
+ * \brief Bounded producer/consumer between cores with semaphores and event flags.
+ *
+ */
+
+
+#ifndef SEMAPHORE_EXAMPLE_H_
+#define SEMAPHORE_EXAMPLE_H_
+
+#include "counting_semaphore.h"
+#include "event_flags.h"
+
+#define ITEM_QUEUE_SIZE 		16
+#define ITEM_BATCH 				4		// the consumer waits for this many items
+#define ITEM_COUNT 				10000	// multiple of ITEM_BATCH
+
+#define EVENT_PRODUCER_DONE 	(1u << 0)
+#define EVENT_CONSUMER_DONE 	(1u << 1)
+
+extern volatile unsigned int items_consumed;
+extern volatile unsigned int items_out_of_order;
+extern volatile unsigned int items_cycles;
+
+void ItemProducer(void);
+// core 0: puts ITEM_COUNT items into the queue, may also be an ISR posting items
+
+void ItemConsumer(void);
+// core 1: blocks until ITEM_BATCH items are ready and takes them at once
+
+void ItemMonitor(void);
+// core 2: blocks until both sides have signalled that they are done
+
+#endif /* SEMAPHORE_EXAMPLE_H_ */
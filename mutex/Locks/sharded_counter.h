@@ -0,0 +1,77 @@
+/**
+ * \file sharded_counter.h
+ * \brief Per-core sharded statistics counters.
+ *
+ */
+
+
+#ifndef SHARDED_COUNTER_H_
+#define SHARDED_COUNTER_H_
+
+#include "atomic_instructions.h"
+
+// A sharded counter has one slot per core. Every core only ever writes its
+// own slot, which is placed in its local DSPR, so an increment is a plain
+// load/add/store without any atomic instruction and without bus traffic to
+// a shared memory. Reading the counter sums all slots; the result is exact
+// once the writers are quiet and otherwise a value that was valid at some
+// point during the read.
+//
+// Each slot has a single writer per core. If a counter is incremented both
+// from task level and from an ISR on the same core, use separate counters
+// or increment it with interrupts disabled.
+//
+// Definition, one slot per core in its own DSPR:
+//
+//   #pragma section fardata "data_cpu0"
+//   unsigned int dmaOk_0;
+//   #pragma section fardata restore
+//   ... same for data_cpu1 / data_cpu2 ...
+//   shardcounter_t dmaOk = SHARDCOUNTER_INIT(&dmaOk_0, &dmaOk_1, &dmaOk_2);
+
+typedef struct shardcounter_t
+{
+	volatile unsigned int* slot[LOCKS_NUM_CORES];
+} shardcounter_t;
+
+#define SHARDCOUNTER_INIT(...) { .slot = { __VA_ARGS__ } }
+
+LOCK_INLINE void AddShardedCounter(shardcounter_t* counter, unsigned int value)
+{
+	*counter->slot[core_id()] += value;
+}
+
+LOCK_INLINE void IncrementShardedCounter(shardcounter_t* counter)
+{
+	AddShardedCounter(counter, 1);
+}
+
+LOCK_INLINE unsigned int ReadShardedCounter(shardcounter_t* counter)
+{
+	unsigned int sum = 0;
+	int i;
+	for (i = 0; i < LOCKS_NUM_CORES; i++)
+	{
+		sum += *counter->slot[i];
+	}
+	return sum;
+}
+
+/* the share of one core, e.g. for per-core statistics */
+LOCK_INLINE unsigned int ReadShardedCounterSlot(shardcounter_t* counter,
+		unsigned int core)
+{
+	return *counter->slot[core];
+}
+
+/* not atomic with respect to concurrent increments */
+LOCK_INLINE void ResetShardedCounter(shardcounter_t* counter)
+{
+	int i;
+	for (i = 0; i < LOCKS_NUM_CORES; i++)
+	{
+		*counter->slot[i] = 0;
+	}
+}
+
+#endif /* SHARDED_COUNTER_H_ */
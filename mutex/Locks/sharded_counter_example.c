@@ -0,0 +1,82 @@
+/**
+ * \file sharded_counter_example.c
+ * \brief Sharded DMA statistics and counter scaling benchmark.
+ *
+ */
+
+#include "sharded_counter_example.h"
+#include "util.h"
+
+#pragma section fardata "data_cpu0"
+unsigned int successfulDma_0 = 0;
+unsigned int failedDma_0 = 0;
+unsigned int benchCounter_0 = 0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu1"
+unsigned int successfulDma_1 = 0;
+unsigned int failedDma_1 = 0;
+unsigned int benchCounter_1 = 0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu2"
+unsigned int successfulDma_2 = 0;
+unsigned int failedDma_2 = 0;
+unsigned int benchCounter_2 = 0;
+#pragma section fardata restore
+
+shardcounter_t successfulDmaTransactions = SHARDCOUNTER_INIT(&successfulDma_0, &successfulDma_1, &successfulDma_2);
+shardcounter_t failedDmaTransactions = SHARDCOUNTER_INIT(&failedDma_0, &failedDma_1, &failedDma_2);
+shardcounter_t benchCounter = SHARDCOUNTER_INIT(&benchCounter_0, &benchCounter_1, &benchCounter_2);
+
+#pragma section fardata "lmudata"
+unsigned int atomicBenchCounter = 0;
+volatile unsigned int counter_bench_sharded[LOCKS_NUM_CORES][LOCKS_NUM_CORES];
+volatile unsigned int counter_bench_atomic[LOCKS_NUM_CORES][LOCKS_NUM_CORES];
+#pragma section fardata restore
+
+static unsigned int benchSharded(void)
+{
+	unsigned int start = cycle_count();
+	int i;
+	for (i = 0; i < COUNTER_BENCH_ITERATIONS; i++)
+	{
+		IncrementShardedCounter(&benchCounter);
+	}
+	return cycle_count() - start;
+}
+
+static unsigned int benchAtomic(void)
+{
+	unsigned int start = cycle_count();
+	int i;
+	for (i = 0; i < COUNTER_BENCH_ITERATIONS; i++)
+	{
+		swap_incr(&atomicBenchCounter);
+	}
+	return cycle_count() - start;
+}
+
+// Runs both counters with 1, 2 and 3 cores incrementing at the same time.
+// The sharded counter stays flat, the cmp_swap counter degrades with every
+// core that contends for the same LMU word.
+void CounterBenchmark(void)
+{
+	unsigned int me = core_id();
+	unsigned int active;
+
+	for (active = 1; active <= LOCKS_NUM_CORES; active++)
+	{
+		synchronizeOtherCores();
+		if (me < active)
+		{
+			counter_bench_sharded[active - 1][me] = benchSharded();
+		}
+
+		synchronizeOtherCores();
+		if (me < active)
+		{
+			counter_bench_atomic[active - 1][me] = benchAtomic();
+		}
+	}
+}
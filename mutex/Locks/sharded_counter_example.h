@@ -0,0 +1,28 @@
+/**
+ * \file sharded_counter_example.h
+ * \brief Sharded DMA statistics and counter scaling benchmark.
+ *
+ */
+
+
+#ifndef SHARDED_COUNTER_EXAMPLE_H_
+#define SHARDED_COUNTER_EXAMPLE_H_
+
+#include "sharded_counter.h"
+
+#define COUNTER_BENCH_ITERATIONS 10000
+
+// Statistics as kept by g_DMA in DMA_Mem_Mem, but safe to update from
+// every core without a lock.
+extern shardcounter_t successfulDmaTransactions;
+extern shardcounter_t failedDmaTransactions;
+
+// cycles per COUNTER_BENCH_ITERATIONS increments, per active core count
+// (index 0..2 = 1..3 cores) and per core
+extern volatile unsigned int counter_bench_sharded[LOCKS_NUM_CORES][LOCKS_NUM_CORES];
+extern volatile unsigned int counter_bench_atomic[LOCKS_NUM_CORES][LOCKS_NUM_CORES];
+
+void CounterBenchmark(void);
+// to be called by all cores at the same time, e.g. after synchronizeOtherCores()
+
+#endif /* SHARDED_COUNTER_EXAMPLE_H_ */
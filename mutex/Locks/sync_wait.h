@@ -0,0 +1,71 @@
+/**
+ * \file sync_wait.h
+ * \brief Spin-then-back-off policy of the blocking synchronization primitives.
+ *
+ */
+
+
+#ifndef SYNC_WAIT_H_
+#define SYNC_WAIT_H_
+
+#include "atomic_instructions.h"
+
+// A waiting core first polls SYNC_SPIN_LIMIT times, which is cheapest when
+// the other side is about to post. After that it calls SYNC_WAIT_HOOK()
+// between polls with an exponentially growing delay, so a long wait does
+// not keep hammering the shared memory the other cores work with.
+//
+// Waits only spin: the core keeps executing __nop()s and never blocks in
+// WAIT, it is not free for other work and draws full power while waiting.
+// The hook does not see the wait condition, so it cannot check it with the
+// interrupts disabled right before WAIT; a post in between would be missed
+// until the next interrupt of the core. A core that has to sleep waits in
+// enterIdle() of Runtime/Idle.h instead, with the poster calling wakeCore().
+// Define SYNC_WAIT_HOOK before including this file to back off differently.
+
+#ifndef SYNC_SPIN_LIMIT
+#define SYNC_SPIN_LIMIT 		64
+#endif
+
+#ifndef SYNC_MAX_DELAY
+#define SYNC_MAX_DELAY 			1024	// __nop()s between polls
+#endif
+
+#ifndef SYNC_WAIT_HOOK
+#define SYNC_WAIT_HOOK(delay) 	sync_delay(delay)
+#endif
+
+typedef struct syncwait_t
+{
+	unsigned int spins;
+	unsigned int delay;
+} syncwait_t;
+
+#define SYNCWAIT_INIT { .spins = 0, .delay = 1 }
+
+LOCK_INLINE void sync_delay(unsigned int delay)
+{
+	unsigned int i;
+	for (i = 0; i < delay; i++)
+	{
+		__nop();
+	}
+}
+
+/* call between two unsuccessful polls */
+LOCK_INLINE void SyncWait(syncwait_t* w)
+{
+	if (w->spins < SYNC_SPIN_LIMIT)
+	{
+		w->spins++;
+		__nop();
+		return;
+	}
+	SYNC_WAIT_HOOK(w->delay);
+	if (w->delay < SYNC_MAX_DELAY)
+	{
+		w->delay <<= 1;
+	}
+}
+
+#endif /* SYNC_WAIT_H_ */
@@ -0,0 +1,84 @@
+/**
+ * \file triple_buffer.h
+ * \brief Wait-free triple buffer for sharing the latest value between two cores.
+ *
+ */
+
+
+#ifndef TRIPLE_BUFFER_H_
+#define TRIPLE_BUFFER_H_
+
+#include "atomic_instructions.h"
+
+// For snapshots where only the newest complete value matters (sensor data,
+// ADC result sets, state flags) and intermediate updates may be dropped.
+// Of the three buffers the writer owns one (back), the reader owns one
+// (front) and the third one (middle) is exchanged between them with a single
+// swap. The writer therefore always has a free buffer to fill, the reader
+// always sees the newest complete one, and neither side ever blocks or
+// retries. One writer and one reader, each of them on a fixed core or ISR.
+
+#define TRIPLEBUFFER_INDEX 	0x3u
+#define TRIPLEBUFFER_NEW 	0x4u	// middle holds data the reader has not seen
+
+typedef struct triplebuffer_t
+{
+	unsigned int middle;		// index | TRIPLEBUFFER_NEW, exchanged with swap
+	unsigned int back;			// writer's buffer
+	unsigned int front;			// reader's buffer
+	unsigned char* buffers;
+	unsigned int size;
+} triplebuffer_t;
+
+/**
+ * storage must hold 3 * size bytes. The first publication is the first
+ * value the reader sees, before that it reads the initial front buffer.
+ */
+LOCK_INLINE void InitTripleBuffer(triplebuffer_t* tb, void* storage, unsigned int size)
+{
+	tb->front = 0;
+	tb->middle = 1;
+	tb->back = 2;
+	tb->buffers = (unsigned char*) storage;
+	tb->size = size;
+	memory_barrier();
+}
+
+/**
+ * Writer: the buffer to fill, always available.
+ */
+LOCK_INLINE void* GetTripleBufferWriteSlot(triplebuffer_t* tb)
+{
+	return tb->buffers + tb->back * tb->size;
+}
+
+/**
+ * Writer: makes the filled buffer the newest one, one atomic swap.
+ */
+LOCK_INLINE void PublishTripleBuffer(triplebuffer_t* tb)
+{
+	memory_barrier();
+	tb->back = swap(&tb->middle, tb->back | TRIPLEBUFFER_NEW) & TRIPLEBUFFER_INDEX;
+}
+
+LOCK_INLINE boolean HasTripleBufferUpdate(triplebuffer_t* tb)
+{
+	return (*(volatile unsigned int*) &tb->middle & TRIPLEBUFFER_NEW) != 0;
+}
+
+/**
+ * Reader: the newest complete buffer. Swaps only if something new has been
+ * published, otherwise returns the same buffer as last time. The buffer
+ * stays valid until the next call.
+ */
+LOCK_INLINE const void* ReadTripleBuffer(triplebuffer_t* tb)
+{
+	if (HasTripleBufferUpdate(tb))
+	{
+		tb->front = swap(&tb->middle, tb->front) & TRIPLEBUFFER_INDEX;
+		memory_barrier();
+	}
+	return tb->buffers + tb->front * tb->size;
+}
+
+#endif /* TRIPLE_BUFFER_H_ */
@@ -0,0 +1,69 @@
+/**
+ * \file triple_buffer_example.c
+ * \brief Latest ADC snapshot shared from core 0 to core 1 through a triple buffer.
+ *
+ */
+
+#include "triple_buffer_example.h"
+
+#pragma section fardata "lmudata"
+adc_snapshot_t snapshot_storage[3];
+triplebuffer_t snapshot_buffer = {
+	.front = 0, .middle = 1, .back = 2,
+	.buffers = (unsigned char*) snapshot_storage, .size = sizeof(adc_snapshot_t)
+};
+volatile unsigned int snapshot_writer_done = 0;
+volatile unsigned int snapshot_reads = 0;
+volatile unsigned int snapshot_torn = 0;
+volatile unsigned int snapshot_stale = 0;
+volatile unsigned int snapshot_publish_cycles = 0;
+#pragma section fardata restore
+
+void SnapshotWriter(void)
+{
+	unsigned int sequence;
+	unsigned int start = cycle_count();
+
+	for (sequence = 1; sequence <= SNAPSHOT_UPDATES; sequence++)
+	{
+		adc_snapshot_t* snapshot = GetTripleBufferWriteSlot(&snapshot_buffer);
+		int i;
+
+		snapshot->sequence = sequence;
+		for (i = 0; i < SNAPSHOT_CHANNELS; i++)
+		{
+			snapshot->result[i] = sequence;
+		}
+		PublishTripleBuffer(&snapshot_buffer);
+	}
+	snapshot_publish_cycles = (cycle_count() - start) / SNAPSHOT_UPDATES;
+
+	memory_barrier();
+	snapshot_writer_done = 1;
+}
+
+void SnapshotReader(void)
+{
+	unsigned int last = 0;
+
+	while (!snapshot_writer_done)
+	{
+		const adc_snapshot_t* snapshot = ReadTripleBuffer(&snapshot_buffer);
+		int i;
+
+		for (i = 0; i < SNAPSHOT_CHANNELS; i++)
+		{
+			if (snapshot->result[i] != snapshot->sequence)
+			{
+				snapshot_torn++;
+				break;
+			}
+		}
+		if (snapshot->sequence < last)
+		{
+			snapshot_stale++;
+		}
+		last = snapshot->sequence;
+		snapshot_reads++;
+	}
+}
@@ -0,0 +1,33 @@
+/**
+ * \file triple_buffer_example.h
+ * \brief Latest ADC snapshot shared from core 0 to core 1 through a triple buffer.
+ *
+ */
+
+
+#ifndef TRIPLE_BUFFER_EXAMPLE_H_
+#define TRIPLE_BUFFER_EXAMPLE_H_
+
+#include "triple_buffer.h"
+
+#define SNAPSHOT_CHANNELS 		32		// 128 byte payload
+#define SNAPSHOT_UPDATES 		100000
+
+typedef struct
+{
+	unsigned int sequence;
+	unsigned int result[SNAPSHOT_CHANNELS];
+} adc_snapshot_t;
+
+extern volatile unsigned int snapshot_reads;
+extern volatile unsigned int snapshot_torn;		// mixed contents of two updates
+extern volatile unsigned int snapshot_stale;	// older than a snapshot seen before
+extern volatile unsigned int snapshot_publish_cycles;
+
+void SnapshotWriter(void);
+// publishes SNAPSHOT_UPDATES snapshots, call it on core 0
+
+void SnapshotReader(void);
+// reads the newest snapshot until the writer is done, call it on core 1
+
+#endif /* TRIPLE_BUFFER_EXAMPLE_H_ */
@@ -129,18 +129,17 @@ void synchronizeWithCore(int otherCore)
 	//barrier();
 }
 
+#pragma section fardata "lmudata"
+corebarrier_t core_sync_barrier = COREBARRIER_INIT(LOCKS_NUM_CORES);
+#pragma section fardata restore
+
+// Replaces the pairwise handshake with every other core (O(n^2) round trips,
+// three cores only) by one reusable sense-reversing barrier.
 void synchronizeOtherCores(void)
 {
-	int myId = getCoreId();
-	int i;
-	for (i = 0; i < 3; i++)
-	{
-		if (i == myId)
-		{
-			continue;
-		}
-		synchronizeWithCore(i);
-	}
-}
-
+	PassCoreBarrier(&core_sync_barrier);
 
+	IfxPort_setPinState(&MODULE_P13, 0, IfxPort_State_low);
+	IfxPort_setPinState(&MODULE_P13, 1, IfxPort_State_low);
+	IfxPort_setPinState(&MODULE_P13, 2, IfxPort_State_low);
+}
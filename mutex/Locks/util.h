@@ -30,6 +30,7 @@
 
 #include "IfxPort.h"
 #include "IfxCpu.h"
+#include "core_barrier.h"
 
 void myBlink(void);
 void blink(int coreId);
@@ -43,6 +44,9 @@ int getCoreId(void);
 
 void synchronizeWithCore(int otherCore);
 void synchronizeOtherCores(void);
+// all LOCKS_NUM_CORES cores meet at core_sync_barrier, may be called back-to-back
+
+extern corebarrier_t core_sync_barrier;
 
 
 #define OLDA_ADDRESS								((void*)0x8FE71000)
@@ -0,0 +1,263 @@
+/**********************************************************************************************************************
+ * \file ActiveObject.c
+ * \brief Active objects: run-to-completion state machines per core fed by lock-free event queues.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "ActiveObject.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+ActiveObject *g_aoObjects[AO_MAX_OBJECTS];                  /* Indexed by priority                                  */
+uint32 g_aoReady[AO_NUM_CORES];                             /* Objects with queued events per core, one bit each    */
+uint32 g_aoSubscribers[AO_MAX_SIGNALS];                     /* Subscribed objects per signal, one bit each          */
+objpool_t *g_aoPools[AO_MAX_POOLS];
+uint32 g_aoPoolCount = 0;
+#pragma section fardata restore
+
+static const AoEvent g_aoEntryEvent = {AO_SIGNAL_ENTRY, 0, 0, 0};
+static const AoEvent g_aoExitEvent = {AO_SIGNAL_EXIT, 0, 0, 0};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Drops one reference, the last one returns the event to its pool */
+static void releaseEvent(const AoEvent *event)
+{
+    if(event->poolId != 0 && swap_add((unsigned int *)&event->refs, (uint32)-1) == 1)
+    {
+        FreePoolObject(g_aoPools[event->poolId - 1], (void *)event);
+    }
+}
+
+/* Multi-producer ring: a producer reserves a position with cmp_swap on tail and marks the slot filled once the
+ * event is stored, so the owner core never sees a half written slot.
+ */
+static boolean enqueue(ActiveObject *me, const AoEvent *event)
+{
+    uint32 position;
+    AoQueueSlot *slot;
+
+    while(1)
+    {
+        position = me->tail;
+        slot = &me->slot[position & (me->length - 1)];
+        if(slot->sequence == position)
+        {
+            if(cmp_swap(&me->tail, position, position + 1))
+            {
+                break;
+            }
+        }
+        else if((sint32)(slot->sequence - position) < 0)
+        {
+            return FALSE;                                   /* Full                                                 */
+        }
+        /* else another producer took the position, try the next one */
+    }
+
+    slot->event = event;
+    memory_barrier();
+    slot->sequence = position + 1;
+
+    memory_barrier();
+    swap_msk(&g_aoReady[me->core], 1u << me->priority, 1u << me->priority);
+    return TRUE;
+}
+
+static const AoEvent *dequeue(ActiveObject *me)
+{
+    AoQueueSlot *slot = &me->slot[me->head & (me->length - 1)];
+    const AoEvent *event;
+
+    if(slot->sequence != me->head + 1)
+    {
+        return 0;
+    }
+    memory_barrier();
+    event = slot->event;
+    slot->sequence = me->head + me->length;                 /* Free for the position one round later                */
+    me->head++;
+    return event;
+}
+
+/* Has to be called once before any object is started */
+void initActiveObjects(void)
+{
+    uint32 i;
+
+    for(i = 0; i < AO_MAX_OBJECTS; i++)
+    {
+        g_aoObjects[i] = 0;
+    }
+    for(i = 0; i < AO_NUM_CORES; i++)
+    {
+        g_aoReady[i] = 0;
+    }
+    for(i = 0; i < AO_MAX_SIGNALS; i++)
+    {
+        g_aoSubscribers[i] = 0;
+    }
+    g_aoPoolCount = 0;
+}
+
+/* Makes an initialized pool usable by newEvent(), returns its poolId or 0 if there is no free pool entry.
+ * The objects of the pool have to start with an AoEvent.
+ */
+uint32 registerEventPool(objpool_t *pool)
+{
+    if(g_aoPoolCount >= AO_MAX_POOLS)
+    {
+        return 0;
+    }
+    g_aoPools[g_aoPoolCount] = pool;
+    g_aoPoolCount++;
+    return g_aoPoolCount;
+}
+
+/* Takes an event from the pool, 0 if the pool is empty. The event is freed when the last queue has dispatched it. */
+AoEvent *newEvent(uint32 poolId, uint16 signal)
+{
+    AoEvent *event = (AoEvent *)AllocPoolObject(g_aoPools[poolId - 1]);
+
+    if(event != 0)
+    {
+        event->signal = signal;
+        event->poolId = (uint8)poolId;
+        event->refs = 0;
+    }
+    return event;
+}
+
+/* Binds the object to core and priority and enters the initial state on the next dispatch of that core */
+boolean startActiveObject(ActiveObject *me, uint32 priority, uint32 core, AoState initial, AoQueueSlot *slot,
+                          uint32 length)
+{
+    uint32 i;
+
+    if(priority >= AO_MAX_OBJECTS || g_aoObjects[priority] != 0 || (length & (length - 1)) != 0)
+    {
+        return FALSE;
+    }
+    for(i = 0; i < length; i++)
+    {
+        slot[i].sequence = i;
+    }
+    me->state = initial;
+    me->priority = priority;
+    me->core = core;
+    me->slot = slot;
+    me->length = length;
+    me->tail = 0;
+    me->head = 0;
+    me->dispatched = 0;
+    me->dropped = 0;
+    memory_barrier();
+    g_aoObjects[priority] = me;
+    return enqueue(me, &g_aoEntryEvent);
+}
+
+/* Queues the event for the object, from any core or ISR. FALSE if the queue is full, the event is dropped then. */
+boolean postEvent(ActiveObject *me, const AoEvent *event)
+{
+    if(event->poolId != 0)
+    {
+        swap_incr((unsigned int *)&event->refs);
+    }
+    if(!enqueue(me, event))
+    {
+        swap_incr(&me->dropped);
+        releaseEvent(event);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Posts the event to every subscriber of its signal, each queue holds one reference */
+void publishEvent(const AoEvent *event)
+{
+    uint32 subscribers = g_aoSubscribers[event->signal];
+
+    /* Own reference, so that a fast subscriber can not free the event before all are posted */
+    if(event->poolId != 0)
+    {
+        swap_incr((unsigned int *)&event->refs);
+    }
+    while(subscribers != 0)
+    {
+        uint32 priority = 31 - count_leading_zeros(subscribers);
+
+        postEvent(g_aoObjects[priority], event);
+        subscribers &= ~(1u << priority);
+    }
+    releaseEvent(event);
+}
+
+void subscribeEvent(ActiveObject *me, uint16 signal)
+{
+    swap_msk(&g_aoSubscribers[signal], 1u << me->priority, 1u << me->priority);
+}
+
+void unsubscribeEvent(ActiveObject *me, uint16 signal)
+{
+    swap_msk(&g_aoSubscribers[signal], 1u << me->priority, 0);
+}
+
+/* Leaves the current state and enters target, to be called from a state handler */
+void transitionActiveObject(ActiveObject *me, AoState target)
+{
+    me->state(me, &g_aoExitEvent);
+    me->state = target;
+    target(me, &g_aoEntryEvent);
+}
+
+/* Dispatches one event to the highest priority object of the calling core, FALSE if no object has an event */
+boolean dispatchActiveObjects(void)
+{
+    uint32 *ready = &g_aoReady[core_id()];
+    uint32 pending = *(volatile uint32 *)ready;
+    uint32 priority;
+    ActiveObject *me;
+    const AoEvent *event;
+
+    if(pending == 0)
+    {
+        return FALSE;
+    }
+    priority = 31 - count_leading_zeros(pending);
+    me = g_aoObjects[priority];
+
+    event = dequeue(me);
+    if(event == 0)
+    {
+        /* Clear the bit before checking again, a post after the check sets it again */
+        swap_msk(ready, 1u << priority, 0);
+        memory_barrier();
+        if(me->slot[me->head & (me->length - 1)].sequence == me->head + 1)
+        {
+            swap_msk(ready, 1u << priority, 1u << priority);
+        }
+        return TRUE;
+    }
+
+    me->state(me, event);
+    me->dispatched++;
+    releaseEvent(event);
+    return TRUE;
+}
+
+/* Event loop of a core, never returns */
+void runActiveObjects(void)
+{
+    while(1)
+    {
+        if(!dispatchActiveObjects())
+        {
+            AO_IDLE_HOOK();
+        }
+    }
+}
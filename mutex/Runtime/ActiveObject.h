@@ -0,0 +1,99 @@
+/**********************************************************************************************************************
+ * \file ActiveObject.h
+ * \brief Active objects: run-to-completion state machines per core fed by lock-free event queues.
+ *
+ * Instead of doing the application work inline, an ISR takes an event from a static event pool, fills it in and posts
+ * it to an active object, or publishes it to all objects subscribed to its signal. Events are immutable once posted.
+ * Every active object has a queue of event pointers, is bound to one core and has a unique priority (0..31, 31 is the
+ * highest). dispatchActiveObjects() on that core hands the next event of the highest priority object with a
+ * non-empty queue to the current state handler, which runs to completion.
+ *
+ * Nothing is allocated at run time: events come from objpool_t pools (Locks/freelist.h) and go back when their
+ * reference count, one per queue holding the event, drops to zero. Post, publish per subscriber and dispatch are O(1)
+ * and lock-free, so any core and any ISR can post. Events that are not from a pool (poolId 0) are never freed, e.g.
+ * constant events.
+ *********************************************************************************************************************/
+
+#ifndef ACTIVEOBJECT_H_
+#define ACTIVEOBJECT_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+#include "Locks/freelist.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define AO_NUM_CORES                LOCKS_NUM_CORES
+#define AO_MAX_OBJECTS              32                      /* Priorities 0..31                                     */
+#define AO_MAX_SIGNALS              64                      /* Signals that can be published                        */
+#define AO_MAX_POOLS                4
+
+/* Reserved signals sent by transitionActiveObject() */
+#define AO_SIGNAL_ENTRY             0
+#define AO_SIGNAL_EXIT              1
+#define AO_SIGNAL_USER              2                       /* First application signal                             */
+
+/* Idle action of runActiveObjects() when no object has an event */
+#ifndef AO_IDLE_HOOK
+#define AO_IDLE_HOOK()              __nop()
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Header of every event, application events start with it */
+typedef struct
+{
+    uint16 signal;
+    uint8 poolId;                                           /* 1 + index of the pool, 0 if not from a pool          */
+    uint8 reserved;
+    uint32 refs;                                            /* Queues still holding the event, atomic               */
+} AoEvent;
+
+typedef struct ActiveObject ActiveObject;
+
+/* State handler, runs to completion */
+typedef void (*AoState)(ActiveObject *me, const AoEvent *event);
+
+typedef struct
+{
+    volatile uint32 sequence;                               /* Slot free for position n: n, filled: n + 1           */
+    const AoEvent *event;
+} AoQueueSlot;
+
+struct ActiveObject
+{
+    AoState state;
+    uint32 priority;
+    uint32 core;
+    AoQueueSlot *slot;
+    uint32 length;                                          /* Queue length, power of two                           */
+    uint32 tail;                                            /* Next position to post to, atomic                     */
+    uint32 head;                                            /* Next position to dispatch, owner core only           */
+    uint32 dispatched;
+    uint32 dropped;                                         /* Posts that found the queue full                      */
+};
+
+/* Defines the queue storage of an active object */
+#define AO_QUEUE_DEFINE(name, length)   AoQueueSlot name[length]
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initActiveObjects(void);
+uint32 registerEventPool(objpool_t *pool);
+AoEvent *newEvent(uint32 poolId, uint16 signal);
+boolean startActiveObject(ActiveObject *me, uint32 priority, uint32 core, AoState initial, AoQueueSlot *slot,
+                          uint32 length);
+boolean postEvent(ActiveObject *me, const AoEvent *event);
+void publishEvent(const AoEvent *event);
+void subscribeEvent(ActiveObject *me, uint16 signal);
+void unsubscribeEvent(ActiveObject *me, uint16 signal);
+void transitionActiveObject(ActiveObject *me, AoState target);
+boolean dispatchActiveObjects(void);
+void runActiveObjects(void);
+
+#endif /* ACTIVEOBJECT_H_ */
@@ -0,0 +1,272 @@
+/**********************************************************************************************************************
+ * \file ActiveObject_Benchmark.c
+ * \brief Event dispatch throughput of the active objects, locally, across cores and with publish.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "ActiveObject_Benchmark.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define SIGNAL_SAMPLE               (AO_SIGNAL_USER + 0)
+#define SIGNAL_TICK                 (AO_SIGNAL_USER + 1)
+#define SIGNAL_MODE                 (AO_SIGNAL_USER + 2)    /* Switches the sampler between its two states          */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    AoEvent super;
+    uint32 value;
+} SampleEvent;
+
+typedef struct
+{
+    ActiveObject super;
+    uint32 samples;
+    uint32 sum;
+    uint32 entries;
+} Sampler;
+
+typedef struct
+{
+    ActiveObject super;
+    uint32 ticks;
+} Subscriber;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+OBJPOOL_DEFINE(g_aoBenchPool, SampleEvent, AO_BENCH_POOL_SIZE);
+uint32 g_aoBenchPoolId;
+Sampler g_aoBenchSampler;
+Subscriber g_aoBenchSubscriber[AO_BENCH_SUBSCRIBERS];
+AO_QUEUE_DEFINE(g_aoBenchSamplerQueue, AO_BENCH_QUEUE_LENGTH);
+AO_QUEUE_DEFINE(g_aoBenchSubscriberQueue[AO_BENCH_SUBSCRIBERS], AO_BENCH_QUEUE_LENGTH);
+volatile uint32 g_aoBenchLocalCycles = 0;
+volatile uint32 g_aoBenchRemoteCycles = 0;
+volatile uint32 g_aoBenchPublishCycles = 0;
+volatile uint32 g_aoBenchErrors = 0;
+volatile uint32 g_aoBenchPhase = 0;                         /* 1: objects started, 2: producers done                */
+volatile uint32 g_aoBenchProducersDone = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void samplerCounting(ActiveObject *me, const AoEvent *event);
+
+static void samplerPaused(ActiveObject *me, const AoEvent *event)
+{
+    if(event->signal == SIGNAL_MODE)
+    {
+        transitionActiveObject(me, samplerCounting);
+    }
+}
+
+static void samplerCounting(ActiveObject *me, const AoEvent *event)
+{
+    Sampler *sampler = (Sampler *)me;
+
+    switch(event->signal)
+    {
+        case AO_SIGNAL_ENTRY:
+            sampler->entries++;
+            break;
+        case SIGNAL_SAMPLE:
+            sampler->samples++;
+            sampler->sum += ((const SampleEvent *)event)->value;
+            break;
+        case SIGNAL_MODE:
+            transitionActiveObject(me, samplerPaused);
+            break;
+        default:
+            break;
+    }
+}
+
+static void subscriberState(ActiveObject *me, const AoEvent *event)
+{
+    if(event->signal == SIGNAL_TICK)
+    {
+        ((Subscriber *)me)->ticks++;
+    }
+}
+
+/* Posts count sample events with the values 1..count, retrying while the pool or the queue is exhausted */
+static void postSamples(uint32 count, boolean dispatch)
+{
+    uint32 i = 1;
+
+    while(i <= count)
+    {
+        SampleEvent *event = (SampleEvent *)newEvent(g_aoBenchPoolId, SIGNAL_SAMPLE);
+
+        if(event != 0)
+        {
+            event->value = i;
+            if(postEvent(&g_aoBenchSampler.super, &event->super))
+            {
+                i++;
+                continue;
+            }
+        }
+        if(dispatch)
+        {
+            dispatchActiveObjects();
+        }
+        else
+        {
+            __nop();
+        }
+    }
+}
+
+static void drain(void)
+{
+    while(dispatchActiveObjects())
+    {
+    }
+}
+
+static void startObjects(void)
+{
+    uint32 i;
+
+    initActiveObjects();
+    InitObjPool(&g_aoBenchPool, g_aoBenchPool_objects, sizeof(SampleEvent), g_aoBenchPool_next, AO_BENCH_POOL_SIZE);
+    g_aoBenchPoolId = registerEventPool(&g_aoBenchPool);
+
+    g_aoBenchSampler.samples = 0;
+    g_aoBenchSampler.sum = 0;
+    g_aoBenchSampler.entries = 0;
+    startActiveObject(&g_aoBenchSampler.super, 1, 0, samplerCounting, g_aoBenchSamplerQueue, AO_BENCH_QUEUE_LENGTH);
+    for(i = 0; i < AO_BENCH_SUBSCRIBERS; i++)
+    {
+        g_aoBenchSubscriber[i].ticks = 0;
+        startActiveObject(&g_aoBenchSubscriber[i].super, 2 + i, 0, subscriberState, g_aoBenchSubscriberQueue[i],
+                          AO_BENCH_QUEUE_LENGTH);
+        subscribeEvent(&g_aoBenchSubscriber[i].super, SIGNAL_TICK);
+    }
+    drain();
+}
+
+static uint32 freeEvents(void)
+{
+    uint32 count = 0;
+    uint32 index;
+    uint32 i;
+    uint32 taken[AO_BENCH_POOL_SIZE];
+
+    while((index = PopFreeList(&g_aoBenchPool.list)) != freelistEMPTY)
+    {
+        taken[count++] = index;
+    }
+    for(i = 0; i < count; i++)
+    {
+        PushFreeList(&g_aoBenchPool.list, taken[i]);
+    }
+    return count;
+}
+
+static void runDispatcher(void)
+{
+    static const AoEvent mode = {SIGNAL_MODE, 0, 0, 0};
+    uint32 expected = AO_BENCH_EVENTS * (AO_BENCH_EVENTS + 1) / 2;
+    uint32 start;
+    uint32 i;
+
+    startObjects();
+
+    /* Local: post and dispatch on core 0 */
+    start = cycle_count();
+    postSamples(AO_BENCH_EVENTS, TRUE);
+    drain();
+    g_aoBenchLocalCycles = (cycle_count() - start) / AO_BENCH_EVENTS;
+    if(g_aoBenchSampler.samples != AO_BENCH_EVENTS || g_aoBenchSampler.sum != expected)
+    {
+        g_aoBenchErrors++;
+    }
+
+    /* Pause and resume once, the entry action counts */
+    postEvent(&g_aoBenchSampler.super, &mode);
+    postEvent(&g_aoBenchSampler.super, &mode);
+    drain();
+
+    /* Remote: cores 1 and 2 post, core 0 dispatches */
+    g_aoBenchSampler.samples = 0;
+    g_aoBenchSampler.sum = 0;
+    g_aoBenchPhase = 1;
+    start = cycle_count();
+    while(g_aoBenchSampler.samples != (AO_NUM_CORES - 1) * AO_BENCH_EVENTS)
+    {
+        if(!dispatchActiveObjects())
+        {
+            __nop();
+        }
+    }
+    g_aoBenchRemoteCycles = (cycle_count() - start) / ((AO_NUM_CORES - 1) * AO_BENCH_EVENTS);
+    if(g_aoBenchSampler.sum != (AO_NUM_CORES - 1) * expected || g_aoBenchSampler.entries != 2)
+    {
+        g_aoBenchErrors++;
+    }
+    while(g_aoBenchProducersDone != AO_NUM_CORES - 1)
+    {
+        __nop();
+    }
+
+    /* Publish to all subscribers */
+    start = cycle_count();
+    for(i = 0; i < AO_BENCH_EVENTS; i++)
+    {
+        AoEvent *tick;
+
+        while((tick = newEvent(g_aoBenchPoolId, SIGNAL_TICK)) == 0)
+        {
+            dispatchActiveObjects();
+        }
+        publishEvent(tick);
+        if((i & 7) == 7)
+        {
+            drain();
+        }
+    }
+    drain();
+    g_aoBenchPublishCycles = (cycle_count() - start) / AO_BENCH_EVENTS;
+    for(i = 0; i < AO_BENCH_SUBSCRIBERS; i++)
+    {
+        if(g_aoBenchSubscriber[i].ticks + g_aoBenchSubscriber[i].super.dropped != AO_BENCH_EVENTS)
+        {
+            g_aoBenchErrors++;
+        }
+    }
+
+    if(freeEvents() != AO_BENCH_POOL_SIZE)
+    {
+        g_aoBenchErrors++;                                  /* An event leaked or was freed twice                   */
+    }
+    g_aoBenchPhase = 2;
+}
+
+void runActiveObjectBenchmark(void)
+{
+    if(core_id() == 0)
+    {
+        g_aoBenchErrors = 0;
+        g_aoBenchProducersDone = 0;
+        runDispatcher();
+        return;
+    }
+
+    while(g_aoBenchPhase != 1)
+    {
+        __nop();
+    }
+    postSamples(AO_BENCH_EVENTS, FALSE);
+    swap_incr((unsigned int *)&g_aoBenchProducersDone);
+}
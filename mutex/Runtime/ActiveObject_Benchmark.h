@@ -0,0 +1,41 @@
+/**********************************************************************************************************************
+ * \file ActiveObject_Benchmark.h
+ * \brief Event dispatch throughput of the active objects, locally, across cores and with publish.
+ *
+ * All objects run on core 0. First core 0 posts to its own object and dispatches, then cores 1 and 2 post sample
+ * events like a peripheral ISR would while core 0 dispatches, and finally core 0 publishes events to four subscribers.
+ * Afterwards every event has to be back in its pool. To be called by all cores at the same time, on a Linux host
+ * with RunOnHostCores(runActiveObjectBenchmark, 3).
+ *********************************************************************************************************************/
+
+#ifndef ACTIVEOBJECT_BENCHMARK_H_
+#define ACTIVEOBJECT_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "ActiveObject.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define AO_BENCH_EVENTS             20000                   /* Events per phase and producer                        */
+#define AO_BENCH_POOL_SIZE          32
+#define AO_BENCH_QUEUE_LENGTH       16
+#define AO_BENCH_SUBSCRIBERS        4
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Cycles (nanoseconds on the host) per dispatched event */
+extern volatile uint32 g_aoBenchLocalCycles;
+extern volatile uint32 g_aoBenchRemoteCycles;
+extern volatile uint32 g_aoBenchPublishCycles;              /* Per published event, all subscribers together        */
+extern volatile uint32 g_aoBenchErrors;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runActiveObjectBenchmark(void);
+
+#endif /* ACTIVEOBJECT_BENCHMARK_H_ */
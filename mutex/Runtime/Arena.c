@@ -0,0 +1,349 @@
+/**********************************************************************************************************************
+ * \file Arena.c
+ * \brief Per-core arena allocator over the LMU: allocation without locks, remote frees, reset per frame.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Arena.h"
+#include "Locks/per_core.h"
+#if !LOCKS_HOST
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define ARENA_NONE                  0xFFFFFFFF              /* End of a list, blocks are addressed by offset        */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 next;                                            /* Offset of the next block while the block is free     */
+    uint32 sizeClass;
+} ArenaHeader;
+
+typedef struct
+{
+    uint32 free[ARENA_CLASSES];                             /* Free list per class, owner only                      */
+    uint32 top;                                             /* Offset of the untouched end                          */
+    ArenaStats stats;
+} ArenaCore;
+
+typedef struct
+{
+    uint32 head;                                            /* Blocks freed by the other cores                      */
+    uint32 busy;                                            /* Remote frees in progress, a reset waits for them     */
+} ArenaRemote;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Only the owner allocates, so its state stays in its DSPR */
+PER_CORE(ArenaCore, g_arena);
+
+/* Remote free list per core, pushed to by the other cores, so in the LMU in cache lines of its own */
+PER_CORE_SHARED(ArenaRemote, g_arenaRemote);
+
+#pragma section fardata "lmudata"
+LOCKS_ALIGNED(LOCKS_CACHE_LINE) uint8 g_arenaMemory[ARENA_NUM_CORES][ARENA_SIZE];
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+
+static boolean disableArenaInterrupts(void)
+{
+    return FALSE;
+}
+
+static void restoreArenaInterrupts(boolean enabled)
+{
+    (void)enabled;
+}
+
+#else
+
+static boolean disableArenaInterrupts(void)
+{
+    return IfxCpu_disableInterrupts();
+}
+
+static void restoreArenaInterrupts(boolean enabled)
+{
+    IfxCpu_restoreInterrupts(enabled);
+}
+
+#endif
+
+static ArenaHeader *getArenaHeader(uint32 core, uint32 offset)
+{
+    return (ArenaHeader *)&g_arenaMemory[core][offset];
+}
+
+/* Smallest class whose blocks hold size bytes and the header */
+static uint32 getSizeClass(uint32 size)
+{
+    uint32 total = size + ARENA_HEADER_SIZE;
+
+    return (total <= ARENA_MIN_BLOCK) ? 0 : (32 - count_leading_zeros(total - 1) - 4);
+}
+
+/* Has to be called once, on one core, before any core allocates */
+void initArenas(void)
+{
+    uint32 core;
+
+    for(core = 0; core < ARENA_NUM_CORES; core++)
+    {
+        ArenaCore *arena = &PER_CORE_ON(g_arena, core);
+        uint8 *bytes = (uint8 *)&arena->stats;
+        uint32 i;
+
+        for(i = 0; i < ARENA_CLASSES; i++)
+        {
+            arena->free[i] = ARENA_NONE;
+        }
+        arena->top = 0;
+        for(i = 0; i < sizeof(ArenaStats); i++)
+        {
+            bytes[i] = 0;
+        }
+        PER_CORE_ON(g_arenaRemote, core).head = ARENA_NONE;
+        PER_CORE_ON(g_arenaRemote, core).busy = 0;
+    }
+}
+
+/* Sorts the blocks freed on other cores into the free lists of the calling core, interrupts have to be disabled */
+static void collectRemoteFrees(uint32 core, ArenaCore *arena)
+{
+    uint32 offset = swap(&PER_CORE_ON(g_arenaRemote, core).head, ARENA_NONE);
+
+    memory_barrier();
+    while(offset != ARENA_NONE)
+    {
+        ArenaHeader *header = getArenaHeader(core, offset);
+        uint32 next = header->next;
+
+        header->next = arena->free[header->sizeClass];
+        arena->free[header->sizeClass] = offset;
+        arena->stats.inUse -= (uint32)ARENA_MIN_BLOCK << header->sizeClass;
+        arena->stats.remoteFrees++;
+        offset = next;
+    }
+}
+
+/* Takes the smallest free block of a larger class and halves it down to the class, the other halves go onto the free
+ * lists. Used once the untouched end is used up, so the blocks are not stranded in the classes freed last.
+ * Interrupts have to be disabled.
+ */
+static uint32 splitFreeBlock(uint32 core, ArenaCore *arena, uint32 sizeClass)
+{
+    uint32 largerClass = sizeClass + 1;
+    uint32 offset;
+
+    while(largerClass < ARENA_CLASSES && arena->free[largerClass] == ARENA_NONE)
+    {
+        largerClass++;
+    }
+    if(largerClass == ARENA_CLASSES)
+    {
+        return ARENA_NONE;
+    }
+    offset = arena->free[largerClass];
+    arena->free[largerClass] = getArenaHeader(core, offset)->next;
+
+    while(largerClass > sizeClass)
+    {
+        ArenaHeader *half;
+
+        largerClass--;
+        half = getArenaHeader(core, offset + ((uint32)ARENA_MIN_BLOCK << largerClass));
+        half->sizeClass = largerClass;
+        half->next = arena->free[largerClass];
+        arena->free[largerClass] = offset + ((uint32)ARENA_MIN_BLOCK << largerClass);
+    }
+    getArenaHeader(core, offset)->sizeClass = sizeClass;
+    return offset;
+}
+
+/* Allocates at least size bytes from the arena of the calling core, 0 if there is no block left */
+void *allocArena(uint32 size)
+{
+    uint32 core = core_id();
+    ArenaCore *arena = &PER_CORE_ON(g_arena, core);
+    uint32 sizeClass;
+    uint32 blockSize;
+    uint32 offset;
+    ArenaHeader *header;
+    boolean interruptState;
+
+    if(size > ARENA_MAX_ALLOC)
+    {
+        arena->stats.failed++;
+        return 0;
+    }
+    sizeClass = getSizeClass(size);
+    blockSize = (uint32)ARENA_MIN_BLOCK << sizeClass;
+
+    interruptState = disableArenaInterrupts();
+    offset = arena->free[sizeClass];
+    if(offset == ARENA_NONE && PER_CORE_ON(g_arenaRemote, core).head != ARENA_NONE)
+    {
+        collectRemoteFrees(core, arena);
+        offset = arena->free[sizeClass];
+    }
+
+    if(offset != ARENA_NONE)
+    {
+        header = getArenaHeader(core, offset);
+        arena->free[sizeClass] = header->next;
+    }
+    else if(arena->top + blockSize > ARENA_SIZE && (offset = splitFreeBlock(core, arena, sizeClass)) != ARENA_NONE)
+    {
+        header = getArenaHeader(core, offset);
+    }
+    else if(arena->top + blockSize <= ARENA_SIZE)
+    {
+        offset = arena->top;
+        arena->top += blockSize;
+        arena->stats.carved = arena->top;
+        arena->stats.peakCarved = (arena->top > arena->stats.peakCarved) ? arena->top : arena->stats.peakCarved;
+        header = getArenaHeader(core, offset);
+        header->sizeClass = sizeClass;
+    }
+    else
+    {
+        arena->stats.failed++;
+        restoreArenaInterrupts(interruptState);
+        return 0;
+    }
+
+    arena->stats.allocs++;
+    arena->stats.inUse += blockSize;
+    restoreArenaInterrupts(interruptState);
+    return header + 1;
+}
+
+/* Returns a block to its owner, from any core. Nothing is done for 0. */
+void freeArena(void *block)
+{
+    ArenaHeader *header = (ArenaHeader *)block - 1;
+    uint32 position;
+    uint32 core;
+    uint32 offset;
+
+    if(block == 0)
+    {
+        return;
+    }
+    /* The owner follows from the address, the header is only touched once a remote free has announced itself */
+    position = (uint32)((uint8 *)header - &g_arenaMemory[0][0]);
+    core = position / ARENA_SIZE;
+    offset = position % ARENA_SIZE;
+
+    if(core == core_id())
+    {
+        ArenaCore *arena = &PER_CORE_ON(g_arena, core);
+        boolean interruptState = disableArenaInterrupts();
+
+        header->next = arena->free[header->sizeClass];
+        arena->free[header->sizeClass] = offset;
+        arena->stats.inUse -= (uint32)ARENA_MIN_BLOCK << header->sizeClass;
+        arena->stats.frees++;
+        restoreArenaInterrupts(interruptState);
+    }
+    else
+    {
+        ArenaRemote *remote = &PER_CORE_ON(g_arenaRemote, core);
+        boolean interruptState = disableArenaInterrupts();  /* A reset of the owner waits for this                  */
+        uint32 head;
+
+        swap_incr(&remote->busy);
+        memory_barrier();
+        do
+        {
+            head = *(volatile uint32 *)&remote->head;
+            header->next = head;
+            memory_barrier();                               /* Link written before the block is published           */
+        } while(!cmp_swap(&remote->head, head, offset));
+        swap_add(&remote->busy, 0xFFFFFFFF);
+        restoreArenaInterrupts(interruptState);
+    }
+}
+
+/* Frees all blocks of the calling core's arena. Remote frees that have announced themselves are waited for and
+ * dropped with the rest of the frame.
+ */
+void resetArena(void)
+{
+    uint32 core = core_id();
+    ArenaCore *arena = &PER_CORE_ON(g_arena, core);
+    ArenaRemote *remote = &PER_CORE_ON(g_arenaRemote, core);
+    boolean interruptState = disableArenaInterrupts();
+    uint32 i;
+
+    while(*(volatile uint32 *)&remote->busy != 0)
+    {
+    }
+    swap(&remote->head, ARENA_NONE);
+    for(i = 0; i < ARENA_CLASSES; i++)
+    {
+        arena->free[i] = ARENA_NONE;
+    }
+    arena->top = 0;
+    arena->stats.inUse = 0;
+    arena->stats.carved = 0;
+    arena->stats.frames++;
+    restoreArenaInterrupts(interruptState);
+}
+
+/* Bytes the block can hold, at least the size it was allocated with */
+uint32 getArenaBlockSize(const void *block)
+{
+    const ArenaHeader *header = (const ArenaHeader *)block - 1;
+
+    return ((uint32)ARENA_MIN_BLOCK << header->sizeClass) - ARENA_HEADER_SIZE;
+}
+
+/* Free bytes of the arena of a core, headers included: its free lists, its remote free list and the untouched end.
+ * stranded receives the part of them in blocks that cannot hold size bytes. Walks the lists, so the arena has to be
+ * quiet, e.g. for statistics while no core allocates or frees.
+ */
+uint32 getArenaFree(uint32 core, uint32 size, uint32 *stranded)
+{
+    ArenaCore *arena = &PER_CORE_ON(g_arena, core);
+    uint32 sizeClass = (size > ARENA_MAX_ALLOC) ? ARENA_CLASSES : getSizeClass(size);
+    uint32 freeBytes = ARENA_SIZE - arena->top;
+    uint32 i;
+
+    /* The untouched end is carved into one block of the class if it is large enough */
+    *stranded = (sizeClass == ARENA_CLASSES || freeBytes < ((uint32)ARENA_MIN_BLOCK << sizeClass)) ? freeBytes : 0;
+    for(i = 0; i <= ARENA_CLASSES; i++)
+    {
+        uint32 offset = (i < ARENA_CLASSES) ? arena->free[i] : PER_CORE_ON(g_arenaRemote, core).head;
+
+        while(offset != ARENA_NONE)
+        {
+            ArenaHeader *header = getArenaHeader(core, offset);
+            uint32 blockSize = (uint32)ARENA_MIN_BLOCK << header->sizeClass;
+
+            freeBytes += blockSize;
+            *stranded += (header->sizeClass < sizeClass) ? blockSize : 0;
+            offset = header->next;
+        }
+    }
+    return freeBytes;
+}
+
+/* Statistics of a core, to be read from any core */
+const ArenaStats *getArenaStats(uint32 core)
+{
+    return &PER_CORE_ON(g_arena, core).stats;
+}
@@ -0,0 +1,70 @@
+/**********************************************************************************************************************
+ * \file Arena.h
+ * \brief Per-core arena allocator over the LMU: allocation without locks, remote frees, reset per frame.
+ *
+ * Every core owns an arena of ARENA_SIZE bytes in the LMU, so blocks can be handed to other cores. allocArena()
+ * rounds the size up to one of ARENA_CLASSES power-of-two size classes and takes a block of that class from the
+ * free list of the calling core, or else carves a new one from the untouched end of its arena. Once the end is used
+ * up, a free block of a larger class is halved down to the class instead; halves are not merged again, the reset
+ * per frame makes up for that. No lock is taken and only taking over the remote frees needs an atomic swap.
+ * Interrupts are disabled for a few instructions, so tasks and ISRs of a core may share its arena.
+ *
+ * freeArena() may be called on any core. A block of the calling core goes back onto its free list. A block of
+ * another core is pushed onto the remote free list of its owner with one compare and swap; the owner takes the whole
+ * list with one swap the next time its free list of the class is empty and sorts it into its free lists. Pushing
+ * single blocks and taking the whole list is free of the ABA problem of lock-free pops.
+ *
+ * resetArena() returns all blocks of the calling core's arena at once, e.g. at the end of every frame of a cyclic
+ * task that allocates its scratch buffers per frame. Blocks of the old frame must not be used anymore then, and that
+ * includes freeing them: a block is freed before the reset of its owner or not at all. The owner of a block follows
+ * from its address, so a remote free only touches the block after announcing itself to the owner. The reset waits
+ * for the remote frees announced until then and drops them with the rest of the frame.
+ *
+ * Blocks are 8-byte aligned and carry an 8-byte header. Requests above the largest class return 0.
+ *********************************************************************************************************************/
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define ARENA_NUM_CORES             LOCKS_NUM_CORES
+#define ARENA_SIZE                  (16 * 1024)             /* Bytes per core                                       */
+#define ARENA_CLASSES               8                       /* Blocks of 16 to 2048 bytes including the header      */
+#define ARENA_MIN_BLOCK             16
+#define ARENA_HEADER_SIZE           8
+#define ARENA_MAX_ALLOC             ((ARENA_MIN_BLOCK << (ARENA_CLASSES - 1)) - ARENA_HEADER_SIZE)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 allocs;
+    uint32 failed;                                          /* Allocations that found no block                      */
+    uint32 frees;                                           /* Frees on the owning core                             */
+    uint32 remoteFrees;                                     /* Frees on other cores, counted when collected         */
+    uint32 inUse;                                           /* Bytes not back on a free list, headers included      */
+    uint32 carved;                                          /* Bytes taken from the untouched end of the arena      */
+    uint32 peakCarved;
+    uint32 frames;                                          /* Resets                                               */
+} ArenaStats;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initArenas(void);
+void *allocArena(uint32 size);
+void freeArena(void *block);
+void resetArena(void);
+uint32 getArenaBlockSize(const void *block);
+uint32 getArenaFree(uint32 core, uint32 size, uint32 *stranded);
+const ArenaStats *getArenaStats(uint32 core);
+
+#endif /* ARENA_H_ */
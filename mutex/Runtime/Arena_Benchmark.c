@@ -0,0 +1,368 @@
+/**********************************************************************************************************************
+ * \file Arena_Benchmark.c
+ * \brief Throughput and fragmentation of the per-core arenas compared to a first-fit heap under one spinlock.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Arena_Benchmark.h"
+#include "Locks/per_core.h"
+#include "Locks/spinlock.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0
+#define BENCH_HEAP_SIZE             (ARENA_NUM_CORES * ARENA_SIZE)
+#define BENCH_HEAP_ALIGN            8
+#define BENCH_HEAP_MIN_BLOCK        16                      /* Smaller rests are not split off                      */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct HeapBlock
+{
+    uint32 size;                                            /* Bytes including this header                          */
+    struct HeapBlock *next;                                 /* Next free block by address while free                */
+} HeapBlock;
+
+typedef struct
+{
+    void *(*alloc)(uint32 size);
+    void (*free)(void *block);
+    uint32 (*blockSize)(void *block);                       /* Bytes the block takes, header included               */
+    uint32 (*freeBytes)(uint32 size, uint32 *stranded);     /* Free bytes, stranded: those too small for size       */
+} BenchAllocator;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Prototypes---------------------------------------------------*/
+/*********************************************************************************************************************/
+static void *allocHeap(uint32 size);
+static void freeHeap(void *block);
+static uint32 getHeapBlockSize(void *block);
+static uint32 getArenaBenchBlockSize(void *block);
+static uint32 getHeapFree(uint32 size, uint32 *stranded);
+static uint32 getArenaBenchFree(uint32 size, uint32 *stranded);
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+volatile ArenaBenchResult g_arenaBenchResult[ArenaBenchPhase_count][ARENA_NUM_CORES];
+volatile uint32 g_arenaBenchInternalFragmentation[ArenaBenchPhase_count];
+volatile uint32 g_arenaBenchExternalFragmentation[ArenaBenchPhase_count];
+volatile uint32 g_arenaBenchArrived = 0;                    /* Cores at a barrier, counts up over the run           */
+uint32 g_arenaBenchLive[ARENA_NUM_CORES][ARENA_BENCH_LIVE]; /* Live blocks of the steady phase, 0 if empty          */
+uint32 g_arenaBenchLiveSize[ARENA_NUM_CORES][ARENA_BENCH_LIVE]; /* Bytes requested for them                         */
+unsigned long g_arenaBenchHeapLock = spinlockFREE;
+HeapBlock *g_arenaBenchHeapFree = 0;                        /* Free blocks ordered by address                       */
+LOCKS_ALIGNED(BENCH_HEAP_ALIGN) uint8 g_arenaBenchHeap[BENCH_HEAP_SIZE];
+#pragma section fardata restore
+
+static const BenchAllocator g_benchAllocator[ArenaBenchPhase_count] = {
+    {allocHeap, freeHeap, getHeapBlockSize, getHeapFree},
+    {allocArena, freeArena, getArenaBenchBlockSize, getArenaBenchFree},
+    {allocHeap, freeHeap, getHeapBlockSize, getHeapFree},
+    {allocArena, freeArena, getArenaBenchBlockSize, getArenaBenchFree}
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* First fit over the address ordered free list, the rest of a block is split off if it is large enough */
+static void *allocHeap(uint32 size)
+{
+    uint32 total = (size + sizeof(HeapBlock) + BENCH_HEAP_ALIGN - 1) & ~(uint32)(BENCH_HEAP_ALIGN - 1);
+    HeapBlock **link;
+    HeapBlock *block;
+
+    GetSpinLock(&g_arenaBenchHeapLock);
+    for(link = &g_arenaBenchHeapFree; *link != 0; link = &(*link)->next)
+    {
+        block = *link;
+        if(block->size >= total)
+        {
+            if(block->size - total >= BENCH_HEAP_MIN_BLOCK)
+            {
+                HeapBlock *rest = (HeapBlock *)((uint8 *)block + total);
+
+                rest->size = block->size - total;
+                rest->next = block->next;
+                block->size = total;
+                *link = rest;
+            }
+            else
+            {
+                *link = block->next;
+            }
+            ReleaseSpinLock(&g_arenaBenchHeapLock);
+            return block + 1;
+        }
+    }
+    ReleaseSpinLock(&g_arenaBenchHeapLock);
+    return 0;
+}
+
+/* Inserts the block by address and merges it with its free neighbours, nothing is done for 0 */
+static void freeHeap(void *pointer)
+{
+    HeapBlock *block = (HeapBlock *)pointer - 1;
+    HeapBlock *previous = 0;
+    HeapBlock *next;
+
+    if(pointer == 0)
+    {
+        return;
+    }
+    GetSpinLock(&g_arenaBenchHeapLock);
+    next = g_arenaBenchHeapFree;
+    while(next != 0 && next < block)
+    {
+        previous = next;
+        next = next->next;
+    }
+
+    if(next != 0 && (uint8 *)block + block->size == (uint8 *)next)
+    {
+        block->size += next->size;
+        next = next->next;
+    }
+    block->next = next;
+    if(previous != 0 && (uint8 *)previous + previous->size == (uint8 *)block)
+    {
+        previous->size += block->size;
+        previous->next = block->next;
+    }
+    else if(previous != 0)
+    {
+        previous->next = block;
+    }
+    else
+    {
+        g_arenaBenchHeapFree = block;
+    }
+    ReleaseSpinLock(&g_arenaBenchHeapLock);
+}
+
+static void initHeap(void)
+{
+    g_arenaBenchHeapFree = (HeapBlock *)g_arenaBenchHeap;
+    g_arenaBenchHeapFree->size = BENCH_HEAP_SIZE;
+    g_arenaBenchHeapFree->next = 0;
+}
+
+static uint32 getHeapBlockSize(void *block)
+{
+    return ((HeapBlock *)block - 1)->size;
+}
+
+static uint32 getArenaBenchBlockSize(void *block)
+{
+    return getArenaBlockSize(block) + ARENA_HEADER_SIZE;
+}
+
+/* Free bytes of the heap, stranded receives those in free blocks too small for size bytes */
+static uint32 getHeapFree(uint32 size, uint32 *stranded)
+{
+    uint32 total = (size + sizeof(HeapBlock) + BENCH_HEAP_ALIGN - 1) & ~(uint32)(BENCH_HEAP_ALIGN - 1);
+    uint32 freeBytes = 0;
+    HeapBlock *block;
+
+    *stranded = 0;
+    for(block = g_arenaBenchHeapFree; block != 0; block = block->next)
+    {
+        freeBytes += block->size;
+        *stranded += (block->size < total) ? block->size : 0;
+    }
+    return freeBytes;
+}
+
+/* Free bytes of all arenas, a request is served by the arena of the calling core only */
+static uint32 getArenaBenchFree(uint32 size, uint32 *stranded)
+{
+    uint32 freeBytes = 0;
+    uint32 core;
+
+    *stranded = 0;
+    for(core = 0; core < ARENA_NUM_CORES; core++)
+    {
+        uint32 coreStranded;
+
+        freeBytes += getArenaFree(core, size, &coreStranded);
+        *stranded += coreStranded;
+    }
+    return freeBytes;
+}
+
+/* Internal: bytes of the live blocks that were not requested, in permille of the bytes the blocks take */
+static uint32 getInternalFragmentation(ArenaBenchPhase phase)
+{
+    uint32 taken = 0;
+    uint32 requested = 0;
+    uint32 core;
+    uint32 slot;
+
+    for(core = 0; core < ARENA_NUM_CORES; core++)
+    {
+        for(slot = 0; slot < ARENA_BENCH_LIVE; slot++)
+        {
+            if(g_arenaBenchLive[core][slot] != 0)
+            {
+                taken += g_benchAllocator[phase].blockSize((void *)g_arenaBenchLive[core][slot]);
+                requested += g_arenaBenchLiveSize[core][slot];
+            }
+        }
+    }
+    return (taken != 0) ? ((taken - requested) * 1000) / taken : 0;
+}
+
+/* External: free bytes that cannot serve the largest request of the benchmark, in permille of the free bytes. The
+ * heap merges free neighbours, the arenas never merge split halves again.
+ */
+static uint32 getExternalFragmentation(ArenaBenchPhase phase)
+{
+    uint32 stranded;
+    uint32 freeBytes = g_benchAllocator[phase].freeBytes(ARENA_BENCH_MAX_SIZE, &stranded);
+
+    return (freeBytes != 0) ? (stranded * 1000) / freeBytes : 0;
+}
+
+static void waitCores(uint32 *barrier)
+{
+    *barrier += ARENA_NUM_CORES;
+    swap_incr((unsigned int *)&g_arenaBenchArrived);
+    while(g_arenaBenchArrived < *barrier)
+    {
+    }
+}
+
+static uint32 nextRandom(uint32 *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void runSteadyPhase(ArenaBenchPhase phase, uint32 *random)
+{
+    const BenchAllocator *allocator = &g_benchAllocator[phase];
+    uint32 core = core_id();
+    volatile ArenaBenchResult *result = &g_arenaBenchResult[phase][core];
+    uint32 start = IfxStm_getLower(BENCH_TIMER);
+    uint32 step;
+
+    for(step = 0; step < ARENA_BENCH_STEPS; step++)
+    {
+        uint32 value = nextRandom(random);
+        uint32 slot = value % ARENA_BENCH_LIVE;
+        uint32 owner = ((step & 3) == 3) ? (core + 1) % ARENA_NUM_CORES : core;
+        uint32 size = 1 + (value >> 8) % ARENA_BENCH_MAX_SIZE;
+        void *block;
+
+        /* Taking the block with swap makes it ours even if its core replaces it at the same time */
+        allocator->free((void *)swap(&g_arenaBenchLive[owner][slot], 0));
+        block = allocator->alloc(size);
+        if(block == 0)
+        {
+            result->failed++;
+        }
+        g_arenaBenchLiveSize[core][slot] = size;            /* Only the core itself fills its slots                 */
+        allocator->free((void *)swap(&g_arenaBenchLive[core][slot], (uint32)block));
+        result->steps++;
+    }
+    result->ticks = IfxStm_getLower(BENCH_TIMER) - start;
+}
+
+static void runFramePhase(ArenaBenchPhase phase, uint32 *random)
+{
+    const BenchAllocator *allocator = &g_benchAllocator[phase];
+    volatile ArenaBenchResult *result = &g_arenaBenchResult[phase][core_id()];
+    void *block[ARENA_BENCH_FRAME_BLOCKS];
+    uint32 start = IfxStm_getLower(BENCH_TIMER);
+    uint32 frame;
+    uint32 i;
+
+    for(frame = 0; frame < ARENA_BENCH_FRAMES; frame++)
+    {
+        for(i = 0; i < ARENA_BENCH_FRAME_BLOCKS; i++)
+        {
+            block[i] = allocator->alloc(1 + (nextRandom(random) >> 8) % ARENA_BENCH_MAX_SIZE);
+            if(block[i] == 0)
+            {
+                result->failed++;
+            }
+            result->steps++;
+        }
+        if(phase == ArenaBenchPhase_arenaFrame)
+        {
+            resetArena();
+        }
+        else
+        {
+            for(i = 0; i < ARENA_BENCH_FRAME_BLOCKS; i++)
+            {
+                if(block[i] != 0)
+                {
+                    allocator->free(block[i]);
+                }
+            }
+        }
+    }
+    result->ticks = IfxStm_getLower(BENCH_TIMER) - start;
+}
+
+void runArenaBenchmark(void)
+{
+    uint32 core = core_id();
+    uint32 random = 0x9E3779B9 * (core + 1);
+    uint32 barrier = 0;
+    ArenaBenchPhase phase;
+    uint32 slot;
+
+    if(core == 0)
+    {
+        initHeap();
+        initArenas();
+    }
+    for(slot = 0; slot < ARENA_BENCH_LIVE; slot++)
+    {
+        g_arenaBenchLive[core][slot] = 0;
+    }
+    waitCores(&barrier);
+
+    for(phase = 0; phase < ArenaBenchPhase_count; phase++)
+    {
+        g_arenaBenchResult[phase][core].steps = 0;
+        g_arenaBenchResult[phase][core].failed = 0;
+
+        if(phase == ArenaBenchPhase_heapSteady || phase == ArenaBenchPhase_arenaSteady)
+        {
+            runSteadyPhase(phase, &random);
+            waitCores(&barrier);
+            if(core == 0)
+            {
+                g_arenaBenchInternalFragmentation[phase] = getInternalFragmentation(phase);
+                g_arenaBenchExternalFragmentation[phase] = getExternalFragmentation(phase);
+            }
+            waitCores(&barrier);
+
+            /* Every core frees what is left of its own blocks and starts the next phase with an empty arena */
+            for(slot = 0; slot < ARENA_BENCH_LIVE; slot++)
+            {
+                g_benchAllocator[phase].free((void *)swap(&g_arenaBenchLive[core][slot], 0));
+            }
+            waitCores(&barrier);
+            resetArena();
+        }
+        else
+        {
+            g_arenaBenchInternalFragmentation[phase] = 0;
+            g_arenaBenchExternalFragmentation[phase] = 0;
+            runFramePhase(phase, &random);
+        }
+        waitCores(&barrier);
+    }
+}
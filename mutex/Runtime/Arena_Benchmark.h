@@ -0,0 +1,68 @@
+/**********************************************************************************************************************
+ * \file Arena_Benchmark.h
+ * \brief Throughput and fragmentation of the per-core arenas compared to a first-fit heap under one spinlock.
+ *
+ * The heap gets the memory of all arenas, ARENA_NUM_CORES * ARENA_SIZE bytes, so both have the same budget. All
+ * cores run every phase at the same time with random sizes up to ARENA_BENCH_MAX_SIZE bytes:
+ *  - steady: every core keeps ARENA_BENCH_LIVE blocks and replaces one per step; every fourth step it frees a block
+ *    of the next core instead of one of its own, which is a remote free for the arenas,
+ *  - frame: every core allocates ARENA_BENCH_FRAME_BLOCKS blocks per frame and drops them at the end of the frame,
+ *    with resetArena() or one free per block on the heap.
+ * Per core the steps, the failed allocations and the STM0 ticks are kept. At the end of the steady phase, with all
+ * blocks still live, both fragmentations of both allocators are taken the same way, in permille:
+ *  - internal: the bytes the live blocks take, headers and rounding included, that were not requested, of the bytes
+ *    they take,
+ *  - external: the free bytes in pieces too small for a request of ARENA_BENCH_MAX_SIZE bytes, of the free bytes.
+ *    For the arenas these are the halves of split blocks that are never merged again and the rest of the untouched
+ *    end; a request is only served by the arena of its own core.
+ *********************************************************************************************************************/
+
+#ifndef ARENA_BENCHMARK_H_
+#define ARENA_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Arena.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define ARENA_BENCH_STEPS           20000                   /* Steps per core in the steady phase                   */
+#define ARENA_BENCH_LIVE            24                      /* Blocks kept per core in the steady phase             */
+#define ARENA_BENCH_MAX_SIZE        500
+#define ARENA_BENCH_FRAMES          500
+#define ARENA_BENCH_FRAME_BLOCKS    16
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef enum
+{
+    ArenaBenchPhase_heapSteady,
+    ArenaBenchPhase_arenaSteady,
+    ArenaBenchPhase_heapFrame,
+    ArenaBenchPhase_arenaFrame,
+    ArenaBenchPhase_count
+} ArenaBenchPhase;
+
+typedef struct
+{
+    uint32 steps;                                           /* Allocations tried                                    */
+    uint32 failed;
+    uint32 ticks;                                           /* STM0 ticks of the phase on the core                  */
+} ArenaBenchResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile ArenaBenchResult g_arenaBenchResult[ArenaBenchPhase_count][ARENA_NUM_CORES];
+extern volatile uint32 g_arenaBenchInternalFragmentation[ArenaBenchPhase_count];    /* Permille, steady phases only */
+extern volatile uint32 g_arenaBenchExternalFragmentation[ArenaBenchPhase_count];    /* Permille, steady phases only */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runArenaBenchmark(void);                               /* To be called on every core                           */
+
+#endif /* ARENA_BENCHMARK_H_ */
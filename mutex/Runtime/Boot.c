@@ -0,0 +1,238 @@
+/**********************************************************************************************************************
+ * \file Boot.c
+ * \brief Parallel multi-core startup: init steps with dependencies run on cores 0..2 and leave a boot trace.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Boot.h"
+#if !LOCKS_HOST
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BOOT_MODEL_MAX_CORES        8                       /* Cores modelBoot() can model                          */
+#define BOOT_NEVER                  0xFFFFFFFF
+
+#if LOCKS_HOST
+#define BOOT_NOW()                  cycle_count()           /* Nanoseconds on the host                              */
+#else
+#define BOOT_NOW()                  IfxStm_getLower(&MODULE_STM0)
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Zero from the C startup of core 0, before cores 1 and 2 are started, so the boot needs no initialization */
+#pragma section fardata "lmudata"
+uint32 g_bootClaimed = 0;                                   /* Steps taken by a core, one bit each                  */
+uint32 g_bootDone = 0;                                      /* Steps finished, one bit each                         */
+BootTraceEntry g_bootTrace[BOOT_MAX_STEPS];
+BootMilestone g_bootMilestones[BOOT_MAX_MILESTONES];
+uint32 g_bootMilestoneCount = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void runStep(const BootStep *step, uint32 index, uint32 core)
+{
+    BootTraceEntry *trace = &g_bootTrace[index];
+
+    trace->core = core;
+    trace->start = BOOT_NOW();
+    step->function();
+    trace->end = BOOT_NOW();
+
+    memory_barrier();                                       /* The results of the step before its done bit          */
+    swap_msk(&g_bootDone, 1u << index, 1u << index);
+}
+
+/* Runs the steps of the table on all cores, to be called on every core with the same table, once after reset.
+ * Returns when all steps are done, FALSE without running a step if the table is not valid or has a dependency cycle.
+ */
+boolean runBoot(const BootStep *table, uint32 count)
+{
+    uint32 all = (count >= BOOT_MAX_STEPS) ? 0xFFFFFFFF : ((1u << count) - 1);
+    uint32 core = core_id();
+    uint32 i;
+
+    if(count > BOOT_MAX_STEPS)
+    {
+        return FALSE;
+    }
+    for(i = 0; i < count; i++)
+    {
+        if((table[i].dependencies & ~all) != 0 || (table[i].core != BOOT_ANY_CORE && table[i].core >= BOOT_NUM_CORES))
+        {
+            return FALSE;
+        }
+    }
+    /* A step waiting for itself, directly or over other steps, would keep every core in the loop below */
+    if(modelBoot(table, count, 0, 1, 0) == BOOT_NEVER)
+    {
+        return FALSE;
+    }
+
+    while(1)
+    {
+        uint32 done = *(volatile uint32 *)&g_bootDone;
+        uint32 claimed = *(volatile uint32 *)&g_bootClaimed;
+        boolean ran = FALSE;
+
+        if(done == all)
+        {
+            break;
+        }
+
+        /* First ready step in table order, claimed with one atomic swap of its bit */
+        for(i = 0; i < count && !ran; i++)
+        {
+            const BootStep *step = &table[i];
+            uint32 bit = 1u << i;
+
+            if((claimed & bit) == 0 && (step->dependencies & ~done) == 0
+               && (step->core == BOOT_ANY_CORE || step->core == core)
+               && (swap_msk(&g_bootClaimed, bit, bit) & bit) == 0)
+            {
+                runStep(step, i, core);
+                ran = TRUE;
+            }
+        }
+        if(!ran)
+        {
+            __nop();
+        }
+    }
+
+    memory_barrier();                                       /* Results of the other cores' steps after the check    */
+    return TRUE;
+}
+
+/* Records the time of a named event, e.g. the first CAN frame sent, from any core */
+void markBootMilestone(const char *name)
+{
+    uint32 index = swap_incr(&g_bootMilestoneCount);
+
+    if(index < BOOT_MAX_MILESTONES)
+    {
+        g_bootMilestones[index].time = BOOT_NOW();
+        g_bootMilestones[index].name = name;
+    }
+}
+
+/* Start and end of every step of the table in STM0 ticks, by table index */
+const BootTraceEntry *getBootTrace(void)
+{
+    return g_bootTrace;
+}
+
+const BootMilestone *getBootMilestones(uint32 *count)
+{
+    *count = (g_bootMilestoneCount < BOOT_MAX_MILESTONES) ? g_bootMilestoneCount : BOOT_MAX_MILESTONES;
+    return g_bootMilestones;
+}
+
+uint32 getBootTicksPerUs(void)
+{
+#if LOCKS_HOST
+    return 1000;
+#else
+    return (uint32)(IfxStm_getFrequency(&MODULE_STM0) / 1000000);
+#endif
+}
+
+/* Durations of the steps of the boot trace in microseconds, as input to modelBoot() */
+void getBootDurations(uint32 count, uint32 *durationUs)
+{
+    uint32 ticksPerUs = getBootTicksPerUs();
+    uint32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        durationUs[i] = (g_bootTrace[i].end - g_bootTrace[i].start) / ticksPerUs;
+    }
+}
+
+/* Replays the table on a model of the given number of cores: at every point in time each free core, in core order,
+ * starts the first step in table order that is ready and allowed on it. Steps pinned to a core the model does not
+ * have go to core 0, so cores = 1 gives the serial boot. Durations are taken from durationUs or, if it is 0, from the
+ * estimates of the table. Fills schedule with start, end and core in microseconds if it is not 0 and returns the
+ * total boot time, or BOOT_NEVER if some steps can never run (a dependency cycle).
+ */
+uint32 modelBoot(const BootStep *table, uint32 count, const uint32 *durationUs, uint32 cores,
+                 BootTraceEntry *schedule)
+{
+    uint32 all = (count >= BOOT_MAX_STEPS) ? 0xFFFFFFFF : ((1u << count) - 1);
+    uint32 busyUntil[BOOT_MODEL_MAX_CORES];
+    uint32 finish[BOOT_MAX_STEPS];
+    uint32 started = 0;
+    uint32 done = 0;
+    uint32 now = 0;
+    uint32 total = 0;
+    uint32 core;
+    uint32 i;
+
+    if(count > BOOT_MAX_STEPS || cores == 0 || cores > BOOT_MODEL_MAX_CORES)
+    {
+        return BOOT_NEVER;
+    }
+    for(core = 0; core < cores; core++)
+    {
+        busyUntil[core] = 0;
+    }
+
+    while(started != all)
+    {
+        uint32 next = BOOT_NEVER;
+
+        for(i = 0; i < count; i++)
+        {
+            if((started & (1u << i)) != 0 && finish[i] <= now)
+            {
+                done |= 1u << i;
+            }
+        }
+
+        for(core = 0; core < cores; core++)
+        {
+            for(i = 0; i < count && busyUntil[core] <= now; i++)
+            {
+                const BootStep *step = &table[i];
+                uint32 stepCore = (step->core == BOOT_ANY_CORE) ? core : ((step->core < cores) ? step->core : 0);
+
+                if((started & (1u << i)) == 0 && (step->dependencies & ~done) == 0 && stepCore == core)
+                {
+                    finish[i] = now + ((durationUs != 0) ? durationUs[i] : step->estimateUs);
+                    started |= 1u << i;
+                    busyUntil[core] = finish[i];
+                    total = (finish[i] > total) ? finish[i] : total;
+                    if(schedule != 0)
+                    {
+                        schedule[i].start = now;
+                        schedule[i].end = finish[i];
+                        schedule[i].core = core;
+                    }
+                }
+            }
+            if(busyUntil[core] > now && busyUntil[core] < next)
+            {
+                next = busyUntil[core];
+            }
+        }
+
+        if(next != BOOT_NEVER)
+        {
+            now = next;
+        }
+        else if(started != all && (started & ~done) == 0)
+        {
+            return BOOT_NEVER;                              /* Nothing running, the rest waits for itself           */
+        }
+        /* else steps of zero duration finished right now, check again */
+    }
+    return total;
+}
@@ -0,0 +1,76 @@
+/**********************************************************************************************************************
+ * \file Boot.h
+ * \brief Parallel multi-core startup: init steps with dependencies run on cores 0..2 and leave a boot trace.
+ *
+ * Instead of core 0 calling every init function in turn while cores 1 and 2 wait on g_cpuSyncEvent, all cores call
+ * runBoot() with the same step table. A step runs once all steps named in its dependency mask are done, either on
+ * the core it is pinned to (e.g. because it reads IfxCpu_getCoreIndex() for the interrupt target) or on the first
+ * core that finds it ready. Every core picks the first ready step in table order, so steps on the critical path
+ * should come first. runBoot() returns on every core once all steps are done, it is a barrier as well.
+ *
+ * For every step the start, end and core are recorded in the boot trace with STM0, which counts from reset, so the
+ * trace shows the time from reset. markBootMilestone() adds named points such as the first CAN frame sent.
+ *
+ * modelBoot() replays the dependency graph with the same policy for a number of cores and step durations, either the
+ * estimates of the table or the durations of a recorded trace, so the speedup of a table can be estimated on the
+ * host or on the target for core counts that were not run. It does not need LOCKS_HOST.
+ *********************************************************************************************************************/
+
+#ifndef BOOT_H_
+#define BOOT_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BOOT_NUM_CORES              LOCKS_NUM_CORES
+#define BOOT_MAX_STEPS              32                      /* One bit per step in the dependency masks             */
+#define BOOT_MAX_MILESTONES         8
+#define BOOT_ANY_CORE               0xFFFFFFFF              /* Step runs on the first core that finds it ready      */
+#define BOOT_AFTER(step)            (1u << (step))          /* Dependency on the step with this table index         */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*BootStepFunction)(void);
+
+typedef struct
+{
+    const char *name;
+    BootStepFunction function;
+    uint32 core;                                            /* Core the step is pinned to or BOOT_ANY_CORE          */
+    uint32 dependencies;                                    /* BOOT_AFTER() of the steps to be done before          */
+    uint32 estimateUs;                                      /* Expected duration, used by modelBoot()               */
+} BootStep;
+
+/* Execution of a step, in STM0 ticks for the boot trace and in microseconds for modelBoot() */
+typedef struct
+{
+    uint32 start;
+    uint32 end;
+    uint32 core;
+} BootTraceEntry;
+
+typedef struct
+{
+    const char *name;
+    uint32 time;                                            /* STM0 ticks                                           */
+} BootMilestone;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+boolean runBoot(const BootStep *table, uint32 count);
+void markBootMilestone(const char *name);
+const BootTraceEntry *getBootTrace(void);
+const BootMilestone *getBootMilestones(uint32 *count);
+uint32 getBootTicksPerUs(void);
+void getBootDurations(uint32 count, uint32 *durationUs);
+uint32 modelBoot(const BootStep *table, uint32 count, const uint32 *durationUs, uint32 cores,
+                 BootTraceEntry *schedule);
+
+#endif /* BOOT_H_ */
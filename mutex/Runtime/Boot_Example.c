@@ -0,0 +1,149 @@
+/**********************************************************************************************************************
+ * \file Boot_Example.c
+ * \brief Parallel startup of the init sequence of the examples, with the serial boot estimated from its trace.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Boot_Example.h"
+#include "IfxStm.h"
+#include "Drivers/VCOM.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BOOT_TIMER                  &MODULE_STM0
+
+/* Table indices, the dependencies refer to them */
+#define STEP_VCOM                   0
+#define STEP_EVADC                  1
+#define STEP_EVADC_CALIBRATION      2
+#define STEP_MCMCAN                 3
+#define STEP_CAN_FIRST_FRAME        4
+#define STEP_UART                   5
+#define STEP_DMA                    6
+#define STEP_LEDS                   7
+#define STEP_COUNT                  8
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Prototypes---------------------------------------------------*/
+/*********************************************************************************************************************/
+static void initEvadc(void);
+static void calibrateEvadc(void);
+static void initMcmcan(void);
+static void sendFirstCanFrame(void);
+static void initUart(void);
+static void initDma(void);
+static void initLeds(void);
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* The long EVADC calibration and the CAN path come first, they are the critical path */
+static const BootStep g_bootExampleTable[STEP_COUNT] = {
+    {"vcom", initVCOMSerialInterface, 0, 0, 400},           /* Interrupt target is the calling core                 */
+    {"evadc", initEvadc, BOOT_ANY_CORE, 0, 200},
+    {"evadc calibration", calibrateEvadc, BOOT_ANY_CORE, BOOT_AFTER(STEP_EVADC), 1500},
+    {"mcmcan", initMcmcan, BOOT_ANY_CORE, 0, 800},
+    {"can first frame", sendFirstCanFrame, BOOT_ANY_CORE, BOOT_AFTER(STEP_MCMCAN), 50},
+    {"uart", initUart, BOOT_ANY_CORE, 0, 300},
+    {"dma", initDma, BOOT_ANY_CORE, BOOT_AFTER(STEP_EVADC_CALIBRATION), 100},
+    {"leds", initLeds, BOOT_ANY_CORE, 0, 20}
+};
+
+#pragma section fardata "lmudata"
+volatile uint32 g_bootExampleMeasuredUs = 0;
+volatile uint32 g_bootExampleFirstCanFrameUs = 0;
+volatile uint32 g_bootExampleSerialUs = 0;
+volatile uint32 g_bootExampleParallelUs = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Stands in for an init function of another example project */
+static void emulateInit(uint32 step)
+{
+    uint32 ticks = (uint32)IfxStm_getTicksFromMicroseconds(BOOT_TIMER, g_bootExampleTable[step].estimateUs);
+    uint32 start = IfxStm_getLower(BOOT_TIMER);
+
+    while((IfxStm_getLower(BOOT_TIMER) - start) < ticks)
+    {
+    }
+}
+
+static void initEvadc(void)
+{
+    emulateInit(STEP_EVADC);
+}
+
+static void calibrateEvadc(void)
+{
+    emulateInit(STEP_EVADC_CALIBRATION);
+}
+
+static void initMcmcan(void)
+{
+    emulateInit(STEP_MCMCAN);
+}
+
+static void sendFirstCanFrame(void)
+{
+    emulateInit(STEP_CAN_FIRST_FRAME);
+    markBootMilestone("first CAN frame");
+}
+
+static void initUart(void)
+{
+    emulateInit(STEP_UART);
+}
+
+static void initDma(void)
+{
+    emulateInit(STEP_DMA);
+}
+
+static void initLeds(void)
+{
+    emulateInit(STEP_LEDS);
+}
+
+void runBootExample(void)
+{
+    const BootTraceEntry *trace;
+    const BootMilestone *milestone;
+    uint32 durationUs[STEP_COUNT];
+    uint32 ticksPerUs;
+    uint32 first;
+    uint32 last;
+    uint32 count;
+    uint32 i;
+
+    runBoot(g_bootExampleTable, STEP_COUNT);
+    if(core_id() != 0)
+    {
+        return;
+    }
+
+    ticksPerUs = getBootTicksPerUs();
+    trace = getBootTrace();
+    first = trace[0].start;
+    last = trace[0].end;
+    for(i = 1; i < STEP_COUNT; i++)
+    {
+        first = ((sint32)(trace[i].start - first) < 0) ? trace[i].start : first;
+        last = ((sint32)(trace[i].end - last) > 0) ? trace[i].end : last;
+    }
+    g_bootExampleMeasuredUs = (last - first) / ticksPerUs;
+
+    milestone = getBootMilestones(&count);
+    if(count > 0)
+    {
+        g_bootExampleFirstCanFrameUs = milestone[0].time / ticksPerUs;
+    }
+
+    getBootDurations(STEP_COUNT, durationUs);
+    g_bootExampleSerialUs = modelBoot(g_bootExampleTable, STEP_COUNT, durationUs, 1, 0);
+    g_bootExampleParallelUs = modelBoot(g_bootExampleTable, STEP_COUNT, durationUs, BOOT_NUM_CORES, 0);
+}
@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+ * \file Boot_Example.h
+ * \brief Parallel startup of the init sequence of the examples, with the serial boot estimated from its trace.
+ *
+ * The steps are those core 0 runs one after the other in the examples: VCOM, UART, EVADC with its startup
+ * calibration, DMA and MCMCAN up to the first CAN frame. Apart from VCOM, which is called, the init functions belong
+ * to the other example projects and are stood in for by waits of their typical duration; they are replaced by the
+ * real functions in a project that has the drivers. Every core calls runBootExample() instead of waiting on
+ * g_cpuSyncEvent, and core 0 no longer calls initVCOMSerialInterface() itself. Afterwards the globals below hold
+ * the measured boot time, the time from reset to the first CAN frame and the boot times modelBoot() gives for the
+ * measured step durations on one core and on three cores, all in us.
+ *********************************************************************************************************************/
+
+#ifndef BOOT_EXAMPLE_H_
+#define BOOT_EXAMPLE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Boot.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile uint32 g_bootExampleMeasuredUs;             /* First step start to last step end                    */
+extern volatile uint32 g_bootExampleFirstCanFrameUs;        /* Reset to the first CAN frame                         */
+extern volatile uint32 g_bootExampleSerialUs;               /* Model of the measured steps on one core              */
+extern volatile uint32 g_bootExampleParallelUs;             /* Model of the measured steps on three cores           */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runBootExample(void);                                  /* To be called on every core                           */
+
+#endif /* BOOT_EXAMPLE_H_ */
@@ -0,0 +1,125 @@
+/**********************************************************************************************************************
+ * \file Coroutine.h
+ * \brief Stackless coroutines (protothreads) for writing polling driver flows sequentially.
+ *
+ * A coroutine is a function whose body is placed between CO_BEGIN and CO_END. Where the blocking version would spin
+ * (wait for a busy flag, retry after a NAK, wait for a received byte) the coroutine uses CO_WAIT_UNTIL and returns
+ * CO_WAITING to its caller; the next call continues right there. The resume point is the source line, stored in a
+ * Coroutine of two bytes, so any number of flows can be interleaved on one core without a stack of their own.
+ *
+ * Rules of the switch/case implementation:
+ *  - local variables do not survive a wait, keep state in the structure passed to the coroutine
+ *  - no switch statement around a CO_ macro inside the body, and at most one CO_ macro per source line
+ *********************************************************************************************************************/
+
+#ifndef COROUTINE_H_
+#define COROUTINE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef enum
+{
+    CO_WAITING = 0,                                         /* Blocked or yielded, call again                       */
+    CO_DONE = 1                                             /* Reached CO_END or CO_EXIT                            */
+} CoStatus;
+
+typedef struct
+{
+    uint16 line;                                            /* Resume point, 0 = start                              */
+} Coroutine;
+
+/* Time-out of a wait, in cycle_count() cycles */
+typedef struct
+{
+    uint32 start;
+    uint32 ticks;
+} CoTimer;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define CO_LINE_DONE                0xFFFF
+
+/* The resume points are case labels reached on purpose by falling through, this keeps -Wimplicit-fallthrough quiet */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define CO_FALLTHROUGH              __attribute__((fallthrough))
+#else
+#define CO_FALLTHROUGH
+#endif
+
+#define CO_INIT(co)                 ((co)->line = 0)
+#define CO_IS_DONE(co)              ((co)->line == CO_LINE_DONE)
+
+#define CO_BEGIN(co)                switch((co)->line) { case 0:
+
+#define CO_END(co)                  } (co)->line = CO_LINE_DONE; return CO_DONE
+
+/* Returns to the caller until cond is true, cond is evaluated again on every call */
+#define CO_WAIT_UNTIL(co, cond)                                 \
+    do                                                          \
+    {                                                           \
+        (co)->line = __LINE__; CO_FALLTHROUGH; case __LINE__:   \
+        if(!(cond))                                             \
+        {                                                       \
+            return CO_WAITING;                                  \
+        }                                                       \
+    } while(0)
+
+#define CO_WAIT_WHILE(co, cond)     CO_WAIT_UNTIL(co, !(cond))
+
+/* Returns to the caller once and continues on the next call */
+#define CO_YIELD(co)                                            \
+    do                                                          \
+    {                                                           \
+        (co)->line = __LINE__;                                  \
+        return CO_WAITING;                                      \
+        case __LINE__:;                                         \
+    } while(0)
+
+/* Runs a child coroutine to its end, call is the invocation of the child with its own Coroutine child */
+#define CO_SPAWN(co, child, call)                               \
+    do                                                          \
+    {                                                           \
+        CO_INIT(child);                                         \
+        CO_WAIT_UNTIL(co, (call) == CO_DONE);                   \
+    } while(0)
+
+#define CO_EXIT(co)                                             \
+    do                                                          \
+    {                                                           \
+        (co)->line = CO_LINE_DONE;                              \
+        return CO_DONE;                                         \
+    } while(0)
+
+#define CO_RESTART(co)                                          \
+    do                                                          \
+    {                                                           \
+        CO_INIT(co);                                            \
+        return CO_WAITING;                                      \
+    } while(0)
+
+#define CO_TIMER_START(timer, cycles)   ((timer)->start = cycle_count(), (timer)->ticks = (cycles))
+#define CO_TIMER_EXPIRED(timer)         ((uint32)(cycle_count() - (timer)->start) >= (timer)->ticks)
+
+/* Waits for cond for at most cycles, afterwards CO_TIMER_EXPIRED(timer) tells which one ended the wait */
+#define CO_WAIT_UNTIL_TIMEOUT(co, timer, cycles, cond)          \
+    do                                                          \
+    {                                                           \
+        CO_TIMER_START(timer, cycles);                          \
+        CO_WAIT_UNTIL(co, (cond) || CO_TIMER_EXPIRED(timer));   \
+    } while(0)
+
+#define CO_DELAY(co, timer, cycles)                             \
+    do                                                          \
+    {                                                           \
+        CO_TIMER_START(timer, cycles);                          \
+        CO_WAIT_UNTIL(co, CO_TIMER_EXPIRED(timer));             \
+    } while(0)
+
+#endif /* COROUTINE_H_ */
@@ -0,0 +1,245 @@
+/**********************************************************************************************************************
+ * \file Coroutine_Benchmark.c
+ * \brief Switch cost and memory of the stackless coroutines, with driver flows interleaved on one core.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Coroutine_Benchmark.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define SIM_I2C_NAKS                5                       /* Transfers NAKed before the EEPROM acknowledges       */
+#define SIM_CAN_BUSY_ROUNDS         4                       /* Rounds the TX buffer stays busy after a send         */
+#define SIM_UART_BYTE_ROUNDS        3                       /* Rounds between two received bytes                    */
+#define UART_TIMEOUT_CYCLES         1000000
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    Coroutine co;
+    uint32 count;
+} YieldFlow;
+
+typedef struct
+{
+    Coroutine co;
+    uint8 mac[6];
+} I2cReadFlow;
+
+typedef struct
+{
+    Coroutine co;
+    CoTimer timer;
+    uint8 received;
+    uint8 data[CO_BENCH_UART_BYTES];
+    uint8 timeouts;
+} UartReceiveFlow;
+
+typedef struct
+{
+    Coroutine co;
+    uint8 sent;
+} CanTransmitFlow;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+volatile uint32 g_coBenchSwitchCycles = 0;
+volatile uint32 g_coBenchCallCycles = 0;
+volatile uint32 g_coBenchCoroutineBytes = 0;
+volatile uint32 g_coBenchFlowBytes[3];
+volatile uint32 g_coBenchFlowRounds = 0;
+volatile uint32 g_coBenchErrors = 0;
+
+YieldFlow g_coBenchYield[CO_BENCH_COROUTINES];
+
+/* Simulated peripherals, advanced once per scheduler round */
+uint32 g_simI2cNaks;
+uint32 g_simCanBusy;
+uint32 g_simUartRound;
+uint8 g_simUartRx;
+boolean g_simUartFull;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void simulatePeripherals(void)
+{
+    if(g_simCanBusy != 0)
+    {
+        g_simCanBusy--;
+    }
+    if(++g_simUartRound == SIM_UART_BYTE_ROUNDS)
+    {
+        g_simUartRound = 0;
+        g_simUartRx++;
+        g_simUartFull = TRUE;
+    }
+}
+
+/* Returns FALSE for a NAK, like IfxI2c_I2c_write/read returning IfxI2c_I2c_Status_nak */
+static boolean simI2cTransfer(void)
+{
+    if(g_simI2cNaks != 0)
+    {
+        g_simI2cNaks--;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static CoStatus yieldFlow(YieldFlow *flow)
+{
+    CO_BEGIN(&flow->co);
+    for(flow->count = 0; flow->count < CO_BENCH_YIELDS; flow->count++)
+    {
+        CO_YIELD(&flow->co);
+    }
+    CO_END(&flow->co);
+}
+
+static CoStatus i2cReadFlow(I2cReadFlow *flow)
+{
+    uint32 i;
+
+    CO_BEGIN(&flow->co);
+    /* Repeat the address write until the EEPROM acknowledges, then the read */
+    CO_WAIT_UNTIL(&flow->co, simI2cTransfer());
+    g_simI2cNaks = SIM_I2C_NAKS;
+    CO_WAIT_UNTIL(&flow->co, simI2cTransfer());
+    for(i = 0; i < 6; i++)
+    {
+        flow->mac[i] = (uint8)(0xA0 + i);
+    }
+    CO_END(&flow->co);
+}
+
+static CoStatus uartReceiveFlow(UartReceiveFlow *flow)
+{
+    CO_BEGIN(&flow->co);
+    while(flow->received < CO_BENCH_UART_BYTES)
+    {
+        CO_WAIT_UNTIL_TIMEOUT(&flow->co, &flow->timer, UART_TIMEOUT_CYCLES, g_simUartFull);
+        if(!g_simUartFull)
+        {
+            flow->timeouts++;
+            CO_EXIT(&flow->co);
+        }
+        g_simUartFull = FALSE;
+        flow->data[flow->received++] = g_simUartRx;
+    }
+    CO_END(&flow->co);
+}
+
+static CoStatus canTransmitFlow(CanTransmitFlow *flow)
+{
+    CO_BEGIN(&flow->co);
+    while(flow->sent < CO_BENCH_CAN_MESSAGES)
+    {
+        CO_WAIT_WHILE(&flow->co, g_simCanBusy != 0);
+        g_simCanBusy = SIM_CAN_BUSY_ROUNDS;                 /* Message handed to the TX buffer                      */
+        flow->sent++;
+    }
+    CO_END(&flow->co);
+}
+
+static void plainCall(YieldFlow *flow)
+{
+    flow->count++;
+}
+
+static void measureSwitch(void)
+{
+    void (*volatile call)(YieldFlow *) = plainCall;
+    uint32 running = CO_BENCH_COROUTINES;
+    uint32 start;
+    uint32 i;
+
+    for(i = 0; i < CO_BENCH_COROUTINES; i++)
+    {
+        CO_INIT(&g_coBenchYield[i].co);
+    }
+
+    start = cycle_count();
+    while(running != 0)
+    {
+        running = 0;
+        for(i = 0; i < CO_BENCH_COROUTINES; i++)
+        {
+            if(yieldFlow(&g_coBenchYield[i]) == CO_WAITING)
+            {
+                running++;
+            }
+        }
+    }
+    g_coBenchSwitchCycles = (cycle_count() - start) / (CO_BENCH_COROUTINES * (CO_BENCH_YIELDS + 1));
+
+    start = cycle_count();
+    for(i = 0; i < CO_BENCH_COROUTINES * (CO_BENCH_YIELDS + 1); i++)
+    {
+        call(&g_coBenchYield[i % CO_BENCH_COROUTINES]);
+    }
+    g_coBenchCallCycles = (cycle_count() - start) / (CO_BENCH_COROUTINES * (CO_BENCH_YIELDS + 1));
+}
+
+static void runDriverFlows(void)
+{
+    I2cReadFlow i2c;
+    UartReceiveFlow uart;
+    CanTransmitFlow can;
+    boolean i2cDone = FALSE;
+    boolean uartDone = FALSE;
+    boolean canDone = FALSE;
+    uint32 i;
+
+    g_simI2cNaks = SIM_I2C_NAKS;
+    g_simCanBusy = 0;
+    g_simUartRound = 0;
+    g_simUartRx = 0;
+    g_simUartFull = FALSE;
+    CO_INIT(&i2c.co);
+    CO_INIT(&uart.co);
+    CO_INIT(&can.co);
+    uart.received = 0;
+    uart.timeouts = 0;
+    can.sent = 0;
+
+    g_coBenchFlowRounds = 0;
+    while(!(i2cDone && uartDone && canDone))
+    {
+        i2cDone = (i2cReadFlow(&i2c) == CO_DONE);
+        uartDone = (uartReceiveFlow(&uart) == CO_DONE);
+        canDone = (canTransmitFlow(&can) == CO_DONE);
+        simulatePeripherals();
+        g_coBenchFlowRounds++;
+    }
+
+    for(i = 0; i < CO_BENCH_UART_BYTES; i++)
+    {
+        if(uart.data[i] != (uint8)(i + 1))
+        {
+            g_coBenchErrors++;
+        }
+    }
+    if(uart.timeouts != 0 || can.sent != CO_BENCH_CAN_MESSAGES || i2c.mac[5] != 0xA5)
+    {
+        g_coBenchErrors++;
+    }
+}
+
+void runCoroutineBenchmark(void)
+{
+    g_coBenchErrors = 0;
+    g_coBenchCoroutineBytes = sizeof(Coroutine);
+    g_coBenchFlowBytes[0] = sizeof(I2cReadFlow);
+    g_coBenchFlowBytes[1] = sizeof(UartReceiveFlow);
+    g_coBenchFlowBytes[2] = sizeof(CanTransmitFlow);
+
+    measureSwitch();
+    runDriverFlows();
+}
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+ * \file Coroutine_Benchmark.h
+ * \brief Switch cost and memory of the stackless coroutines, with driver flows interleaved on one core.
+ *
+ * The switch cost is the time of one resume plus yield, measured over CO_BENCH_COROUTINES coroutines that each yield
+ * CO_BENCH_YIELDS times, next to the cost of a plain call through a function pointer. The memory of a coroutine is
+ * its Coroutine plus whatever the flow keeps across waits; there is no stack per coroutine.
+ *
+ * The driver flows are the blocking loops of the examples written as coroutines against simulated peripherals: an
+ * I2C EEPROM that NAKs while busy (read_ext_device_address), a UART receive with time-out instead of TIME_INFINITE
+ * and a CAN transmit that waits while the TX buffer is busy (transmitCanMessage). All three progress together.
+ * Single core, also on a Linux host with LOCKS_HOST=1.
+ *********************************************************************************************************************/
+
+#ifndef COROUTINE_BENCHMARK_H_
+#define COROUTINE_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Coroutine.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define CO_BENCH_COROUTINES         64
+#define CO_BENCH_YIELDS             1000
+#define CO_BENCH_UART_BYTES         16                      /* Bytes the UART flow receives                         */
+#define CO_BENCH_CAN_MESSAGES       8                       /* Messages the CAN flow sends                          */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile uint32 g_coBenchSwitchCycles;               /* Cycles per resume + yield (ns on the host)           */
+extern volatile uint32 g_coBenchCallCycles;                 /* Cycles per plain function pointer call               */
+extern volatile uint32 g_coBenchCoroutineBytes;             /* sizeof(Coroutine)                                    */
+extern volatile uint32 g_coBenchFlowBytes[3];               /* Whole state of the I2C, UART and CAN flow            */
+extern volatile uint32 g_coBenchFlowRounds;                 /* Scheduler rounds until all three flows were done     */
+extern volatile uint32 g_coBenchErrors;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runCoroutineBenchmark(void);
+
+#endif /* COROUTINE_BENCHMARK_H_ */
@@ -0,0 +1,358 @@
+/**********************************************************************************************************************
+ * \file CpuLoad.c
+ * \brief Per-core CPU load accounting: idle, task and per ISR time from the CCNT cycle counter.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "CpuLoad.h"
+#include "Locks/per_core.h"
+#if !LOCKS_HOST
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxScuCcu.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define CPU_LOAD_CYCLE_MASK         0x7FFFFFFF              /* CCNT counts in bits 0..30, bit 31 is sticky overflow */
+#define CPU_LOAD_PRIORITIES         256
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Written by the own core on every slot switch, so it is kept in its DSPR */
+PER_CORE(CpuLoadAccount, g_cpuLoad);
+
+#pragma section fardata "lmudata"
+uint8 g_cpuLoadIsrSlot[CPU_LOAD_PRIORITIES];                /* Slot per ISR priority, 0 if not registered           */
+const char *g_cpuLoadIsrName[CPU_LOAD_MAX_ISRS];
+uint32 g_cpuLoadIsrCount = 0;
+uint32 g_cpuLoadWindowCycles[CPU_LOAD_NUM_CORES];           /* CCNT cycles of a window per core                     */
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+
+static boolean disableAccounting(void)
+{
+    return FALSE;
+}
+
+static void restoreAccounting(boolean enabled)
+{
+    (void)enabled;
+}
+
+/* Enables CCNT of the calling core, returns its cycles per millisecond */
+static uint32 startCycleCounter(void)
+{
+    return 1000000;                                         /* cycle_count() counts nanoseconds on the host         */
+}
+
+#else
+
+static boolean disableAccounting(void)
+{
+    return IfxCpu_disableInterrupts();
+}
+
+static void restoreAccounting(boolean enabled)
+{
+    IfxCpu_restoreInterrupts(enabled);
+}
+
+static uint32 startCycleCounter(void)
+{
+    enable_cycle_counter();
+    return (uint32)(IfxScuCcu_getCpuFrequency((IfxCpu_ResourceCpu)core_id()) / 1000);
+}
+
+#endif
+
+/* Adds the cycles since the last switch to the current slot, interrupts of the core have to be disabled */
+static void chargeCycles(CpuLoadAccount *account)
+{
+    uint32 now = cycle_count();
+
+    account->cycles[account->slot] += (now - account->lastCycles) & CPU_LOAD_CYCLE_MASK;
+    account->lastCycles = now;
+}
+
+static uint16 toPermille(uint32 cycles, uint32 window)
+{
+    return (window != 0) ? (uint16)(((uint64)cycles * 1000) / window) : 0;
+}
+
+/* To be called once on every core before its load is accounted. The core counts as running a task. */
+void initCpuLoad(void)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+    uint8 *bytes = (uint8 *)account;
+    uint32 i;
+
+    for(i = 0; i < sizeof(CpuLoadAccount); i++)
+    {
+        bytes[i] = 0;
+    }
+    g_cpuLoadWindowCycles[core_id()] = startCycleCounter() * CPU_LOAD_WINDOW_MS;
+    account->slot = CPU_LOAD_SLOT_TASK;
+    account->lastCycles = cycle_count();
+    account->windowStart = account->lastCycles;
+}
+
+/* Gives the ISR priority a slot of its own on every core, FALSE if all slots are taken. To be called before the
+ * ISR is first accounted, from one core only.
+ */
+boolean registerCpuLoadIsr(uint32 priority, const char *name)
+{
+    if(priority == 0 || priority >= CPU_LOAD_PRIORITIES)
+    {
+        return FALSE;
+    }
+    if(g_cpuLoadIsrSlot[priority] == 0)
+    {
+        if(g_cpuLoadIsrCount >= CPU_LOAD_MAX_ISRS)
+        {
+            return FALSE;
+        }
+        g_cpuLoadIsrName[g_cpuLoadIsrCount] = name;
+        g_cpuLoadIsrSlot[priority] = (uint8)(CPU_LOAD_SLOT_ISR + g_cpuLoadIsrCount);
+        g_cpuLoadIsrCount++;
+    }
+    return TRUE;
+}
+
+/* Switches to the slot of the ISR, returns the slot to go back to. Interrupts are still disabled on ISR entry. */
+uint32 enterCpuLoadIsr(uint32 priority)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+    uint32 previous = account->slot;
+    uint32 slot = g_cpuLoadIsrSlot[priority & (CPU_LOAD_PRIORITIES - 1)];
+
+    chargeCycles(account);
+    account->slot = (slot != 0) ? slot : CPU_LOAD_SLOT_ISR_OTHER;
+    return previous;
+}
+
+/* Switches back to the slot that was interrupted, interrupts are disabled again by the ISR return anyway */
+void exitCpuLoadIsr(uint32 previous)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+    boolean enabled = disableAccounting();
+
+    chargeCycles(account);
+    account->slot = previous;
+    restoreAccounting(enabled);
+}
+
+/* The calling core is idle from now on, e.g. before the while(1) of a main function */
+void enterCpuLoadIdle(void)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+    boolean enabled = disableAccounting();
+
+    chargeCycles(account);
+    account->slot = CPU_LOAD_SLOT_IDLE;
+    restoreAccounting(enabled);
+}
+
+/* The calling core runs a task from now on */
+void leaveCpuLoadIdle(void)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+    boolean enabled = disableAccounting();
+
+    chargeCycles(account);
+    account->slot = CPU_LOAD_SLOT_TASK;
+    restoreAccounting(enabled);
+}
+
+/* Closes the window of the calling core and updates its averages. The window length is measured, so calling it
+ * late only makes the window longer.
+ */
+void updateCpuLoad(void)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+    uint32 cycles[CPU_LOAD_SLOTS];
+    uint32 window;
+    uint32 windows;
+    uint32 index;
+    uint32 slot;
+    boolean enabled = disableAccounting();
+
+    chargeCycles(account);
+    window = (account->lastCycles - account->windowStart) & CPU_LOAD_CYCLE_MASK;
+    account->windowStart = account->lastCycles;
+    for(slot = 0; slot < CPU_LOAD_SLOTS; slot++)
+    {
+        cycles[slot] = account->cycles[slot];
+        account->cycles[slot] = 0;
+    }
+    restoreAccounting(enabled);
+
+    index = account->windows % CPU_LOAD_HISTORY;
+    account->windows++;
+    windows = (account->windows < CPU_LOAD_HISTORY) ? account->windows : CPU_LOAD_HISTORY;
+    for(slot = 0; slot < CPU_LOAD_SLOTS; slot++)
+    {
+        uint16 load = toPermille(cycles[slot], window);
+
+        account->windowSum[slot] += (uint32)load - account->windowLoad[index][slot];
+        account->windowLoad[index][slot] = load;
+        account->load[CpuLoadPeriod_100ms][slot] = load;
+        account->load[CpuLoadPeriod_1s][slot] = (uint16)(account->windowSum[slot] / windows);
+    }
+
+    /* A second is complete, the 1 s average is its load */
+    if((account->windows % CPU_LOAD_HISTORY) == 0)
+    {
+        uint32 seconds = account->windows / CPU_LOAD_HISTORY;
+
+        index = (seconds - 1) % CPU_LOAD_HISTORY;
+        seconds = (seconds < CPU_LOAD_HISTORY) ? seconds : CPU_LOAD_HISTORY;
+        for(slot = 0; slot < CPU_LOAD_SLOTS; slot++)
+        {
+            uint16 load = account->load[CpuLoadPeriod_1s][slot];
+
+            account->secondSum[slot] += (uint32)load - account->secondLoad[index][slot];
+            account->secondLoad[index][slot] = load;
+            account->load[CpuLoadPeriod_10s][slot] = (uint16)(account->secondSum[slot] / seconds);
+        }
+    }
+    else if(account->windows < CPU_LOAD_HISTORY)
+    {
+        /* No second yet, the 10 s average is what there is */
+        for(slot = 0; slot < CPU_LOAD_SLOTS; slot++)
+        {
+            account->load[CpuLoadPeriod_10s][slot] = account->load[CpuLoadPeriod_1s][slot];
+        }
+    }
+}
+
+/* TRUE once the window of the calling core has passed, short enough for the pending check of idle work */
+boolean isCpuLoadWindowOver(void)
+{
+    CpuLoadAccount *account = &PER_CORE_THIS(g_cpuLoad);
+
+    return ((cycle_count() - account->windowStart) & CPU_LOAD_CYCLE_MASK) >= g_cpuLoadWindowCycles[core_id()];
+}
+
+/* Updates the load of the calling core once its window has passed, TRUE if it did */
+boolean pollCpuLoad(void)
+{
+    if(!isCpuLoadWindowOver())
+    {
+        return FALSE;
+    }
+    updateCpuLoad();
+    return TRUE;
+}
+
+/* Load of a slot of the core in permille, from any core */
+uint32 getCpuLoad(uint32 core, CpuLoadPeriod period, uint32 slot)
+{
+    return ((volatile CpuLoadAccount *)&PER_CORE_ON(g_cpuLoad, core))->load[period][slot];
+}
+
+/* Load of all ISRs of the core in permille, from any core */
+uint32 getCpuLoadIsr(uint32 core, CpuLoadPeriod period)
+{
+    uint32 load = 0;
+    uint32 slot;
+
+    for(slot = CPU_LOAD_SLOT_ISR_OTHER; slot < CPU_LOAD_SLOTS; slot++)
+    {
+        load += getCpuLoad(core, period, slot);
+    }
+    return load;
+}
+
+static void appendText(char *buffer, uint32 size, uint32 *length, const char *text)
+{
+    while(*text != 0 && *length + 1 < size)
+    {
+        buffer[(*length)++] = *text++;
+    }
+    buffer[*length] = 0;
+}
+
+/* Permille as percent with one decimal, right aligned to 6 characters, e.g. "  12.3" */
+static void appendPercent(char *buffer, uint32 size, uint32 *length, uint32 permille)
+{
+    char text[8];
+    uint32 i = sizeof(text) - 1;
+
+    text[i] = 0;
+    text[--i] = (char)('0' + permille % 10);
+    text[--i] = '.';
+    permille /= 10;
+    do
+    {
+        text[--i] = (char)('0' + permille % 10);
+        permille /= 10;
+    } while(permille != 0 && i > 2);
+    while(i > 1)
+    {
+        text[--i] = ' ';
+    }
+    appendText(buffer, size, length, &text[1]);
+}
+
+static void appendLoads(char *buffer, uint32 size, uint32 *length, uint32 core, uint32 slot)
+{
+    CpuLoadPeriod period;
+
+    for(period = CpuLoadPeriod_100ms; period < CpuLoadPeriod_count; period++)
+    {
+        uint32 load = (slot == CPU_LOAD_SLOTS) ? getCpuLoadIsr(core, period) : getCpuLoad(core, period, slot);
+
+        appendPercent(buffer, size, length, load);
+    }
+}
+
+/* Writes the loads of all cores as text lines into buffer, in percent over 100 ms, 1 s and 10 s, e.g.
+ *
+ *     cpu0 idle  71.2  70.8  70.9 task  25.0  25.3  25.2 isr   3.8   3.9   3.9
+ *       asc0 tx   3.1   3.2   3.2
+ *
+ * Returns the length of the text, which is always terminated.
+ */
+uint32 formatCpuLoad(char *buffer, uint32 size)
+{
+    uint32 length = 0;
+    uint32 core;
+    uint32 isr;
+
+    buffer[0] = 0;
+    for(core = 0; core < CPU_LOAD_NUM_CORES; core++)
+    {
+        char name[] = "cpu0";
+
+        name[3] = (char)('0' + core);
+        appendText(buffer, size, &length, name);
+        appendText(buffer, size, &length, " idle");
+        appendLoads(buffer, size, &length, core, CPU_LOAD_SLOT_IDLE);
+        appendText(buffer, size, &length, " task");
+        appendLoads(buffer, size, &length, core, CPU_LOAD_SLOT_TASK);
+        appendText(buffer, size, &length, " isr");
+        appendLoads(buffer, size, &length, core, CPU_LOAD_SLOTS);
+        appendText(buffer, size, &length, "\r\n");
+
+        for(isr = 0; isr < g_cpuLoadIsrCount; isr++)
+        {
+            appendText(buffer, size, &length, "  ");
+            appendText(buffer, size, &length, g_cpuLoadIsrName[isr]);
+            appendLoads(buffer, size, &length, core, CPU_LOAD_SLOT_ISR + isr);
+            appendText(buffer, size, &length, "\r\n");
+        }
+        appendText(buffer, size, &length, "  other");
+        appendLoads(buffer, size, &length, core, CPU_LOAD_SLOT_ISR_OTHER);
+        appendText(buffer, size, &length, "\r\n");
+    }
+    return length;
+}
@@ -0,0 +1,98 @@
+/**********************************************************************************************************************
+ * \file CpuLoad.h
+ * \brief Per-core CPU load accounting: idle, task and per ISR time from the CCNT cycle counter.
+ *
+ * Every cycle of a core is charged to exactly one slot: idle, task (background code that is not idle) or the
+ * interrupt service routine running. A slot switch reads CCNT, adds the cycles since the last switch to the old slot
+ * and makes the new one current, so the accounting costs a few cycles per ISR and nothing in between. ISRs are
+ * bracketed with CPU_LOAD_ISR_BEGIN/CPU_LOAD_ISR_END and identified by their priority, which is unique per core.
+ * Priorities registered with registerCpuLoadIsr() get a slot of their own, all others share the slot "other ISRs".
+ * The cycles of a nested ISR are charged to it only, not to the ISR it interrupts.
+ *
+ * updateCpuLoad() closes a window of CPU_LOAD_WINDOW_MS on the calling core and updates the rolling averages over
+ * the last window (100 ms), the last CPU_LOAD_HISTORY windows (1 s) and the last CPU_LOAD_HISTORY seconds (10 s), in
+ * permille of the cycles of the core. pollCpuLoad() calls it once the window has passed, e.g. from the idle loop.
+ * The idle slot is charged by enterIdle() of Idle.h for the time in WAIT, or by enterCpuLoadIdle/leaveCpuLoadIdle.
+ * The results stay in the DSPR of every core and can be read from any core with getCpuLoad() or formatted as text
+ * with formatCpuLoad() to be streamed over the UART.
+ *
+ * CCNT is 31 bits wide and wraps after about 7 s at 300 MHz, a window has to be shorter.
+ *********************************************************************************************************************/
+
+#ifndef CPULOAD_H_
+#define CPULOAD_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define USE_CPU_LOAD                0                       /* Opt-in: accounting and a VCOM report every second    */
+
+#define CPU_LOAD_NUM_CORES          LOCKS_NUM_CORES
+#define CPU_LOAD_WINDOW_MS          100
+#define CPU_LOAD_HISTORY            10                      /* Windows per second and seconds per 10 s average      */
+#define CPU_LOAD_MAX_ISRS           16                      /* ISR priorities with a slot of their own              */
+
+/* Slots of the cycles */
+#define CPU_LOAD_SLOT_IDLE          0
+#define CPU_LOAD_SLOT_TASK          1
+#define CPU_LOAD_SLOT_ISR_OTHER     2                       /* ISRs that are not registered                         */
+#define CPU_LOAD_SLOT_ISR           3                       /* First registered ISR                                 */
+#define CPU_LOAD_SLOTS              (CPU_LOAD_SLOT_ISR + CPU_LOAD_MAX_ISRS)
+
+/* First statement of an accounted ISR, before interrupts are enabled again, and last statement */
+#if USE_CPU_LOAD
+#define CPU_LOAD_ISR_BEGIN(priority)    uint32 cpuLoadPrevious = enterCpuLoadIsr(priority)
+#define CPU_LOAD_ISR_END()              exitCpuLoadIsr(cpuLoadPrevious)
+#else
+#define CPU_LOAD_ISR_BEGIN(priority)
+#define CPU_LOAD_ISR_END()
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef enum
+{
+    CpuLoadPeriod_100ms,                                    /* Last window                                          */
+    CpuLoadPeriod_1s,                                       /* Last CPU_LOAD_HISTORY windows                        */
+    CpuLoadPeriod_10s,                                      /* Last CPU_LOAD_HISTORY seconds                        */
+    CpuLoadPeriod_count
+} CpuLoadPeriod;
+
+/* Accounting state of one core, written by that core only */
+typedef struct
+{
+    uint32 lastCycles;                                      /* CCNT at the last slot switch                         */
+    uint32 slot;                                            /* Slot the cycles since lastCycles belong to           */
+    uint32 cycles[CPU_LOAD_SLOTS];                          /* Cycles of the current window                         */
+    uint32 windowStart;                                     /* CCNT at the start of the current window              */
+    uint32 windows;                                         /* Windows closed                                       */
+    uint16 windowLoad[CPU_LOAD_HISTORY][CPU_LOAD_SLOTS];    /* Permille of the last windows, ring                   */
+    uint16 secondLoad[CPU_LOAD_HISTORY][CPU_LOAD_SLOTS];    /* Permille of the last seconds, ring                   */
+    uint32 windowSum[CPU_LOAD_SLOTS];                       /* Sum of windowLoad                                    */
+    uint32 secondSum[CPU_LOAD_SLOTS];                       /* Sum of secondLoad                                    */
+    uint16 load[CpuLoadPeriod_count][CPU_LOAD_SLOTS];       /* Results in permille, read by any core                */
+} CpuLoadAccount;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initCpuLoad(void);
+boolean registerCpuLoadIsr(uint32 priority, const char *name);
+uint32 enterCpuLoadIsr(uint32 priority);
+void exitCpuLoadIsr(uint32 previous);
+void enterCpuLoadIdle(void);
+void leaveCpuLoadIdle(void);
+void updateCpuLoad(void);
+boolean isCpuLoadWindowOver(void);
+boolean pollCpuLoad(void);
+uint32 getCpuLoad(uint32 core, CpuLoadPeriod period, uint32 slot);
+uint32 getCpuLoadIsr(uint32 core, CpuLoadPeriod period);
+uint32 formatCpuLoad(char *buffer, uint32 size);
+
+#endif /* CPULOAD_H_ */
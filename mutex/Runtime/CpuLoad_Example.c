@@ -0,0 +1,116 @@
+/**********************************************************************************************************************
+ * \file CpuLoad_Example.c
+ * \brief Load accounting of the three cores of the example, streamed over the VCOM UART.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "CpuLoad_Example.h"
+#include "Drivers/VCOM.h"
+#include "Locks/lock_example.h"
+#include "Thread.h"
+#include "IfxStm.h"
+
+/* The window tick takes comparator 1 of the STMs, comparator 0 belongs to the time-triggered executive */
+#if USE_CPU_LOAD && USE_THREAD_SLICE
+#error "The CPU load tick and the thread time slice both use STM comparator 1, set USE_THREAD_SLICE to 0"
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "data_cpu0"
+char g_cpuLoadReport[CPU_LOAD_REPORT_SIZE];
+uint32 g_cpuLoadReportWindows = 0;
+#pragma section fardata restore
+
+static Ifx_STM *const g_cpuLoadStm[CPU_LOAD_NUM_CORES] = {&MODULE_STM0, &MODULE_STM1, &MODULE_STM2};
+static const IfxSrc_Tos g_cpuLoadTos[CPU_LOAD_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+static uint32 g_cpuLoadTickTicks[CPU_LOAD_NUM_CORES];
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* To be called first in the main function of every core */
+void initCpuLoadExample(void)
+{
+    initCpuLoad();
+    if(core_id() == CPU_LOAD_REPORT_CORE)
+    {
+        registerCpuLoadIsr(ISR_PRIORITY_VCOM_0_RX, "asc0 rx");
+        registerCpuLoadIsr(ISR_PRIORITY_VCOM_0_TX, "asc0 tx");
+        registerCpuLoadIsr(ISR_PRIORITY_VCOM_0_EX, "asc0 ex");
+    }
+}
+
+IFX_INTERRUPT(cpuLoadTickIsrCpu0, 0, ISR_PRIORITY_CPU_LOAD_TICK);
+IFX_INTERRUPT(cpuLoadTickIsrCpu1, 1, ISR_PRIORITY_CPU_LOAD_TICK);
+IFX_INTERRUPT(cpuLoadTickIsrCpu2, 2, ISR_PRIORITY_CPU_LOAD_TICK);
+
+/* Only ends the WAIT of the idle loop, closing the window is its idle work */
+static void cpuLoadTick(uint32 core)
+{
+    CPU_LOAD_ISR_BEGIN(ISR_PRIORITY_CPU_LOAD_TICK);
+    IfxStm_clearCompareFlag(g_cpuLoadStm[core], IfxStm_Comparator_1);
+    IfxStm_increaseCompare(g_cpuLoadStm[core], IfxStm_Comparator_1, g_cpuLoadTickTicks[core]);
+    CPU_LOAD_ISR_END();
+}
+
+void cpuLoadTickIsrCpu0(void)
+{
+    cpuLoadTick(0);
+}
+
+void cpuLoadTickIsrCpu1(void)
+{
+    cpuLoadTick(1);
+}
+
+void cpuLoadTickIsrCpu2(void)
+{
+    cpuLoadTick(2);
+}
+
+static void startCpuLoadTick(void)
+{
+    uint32 core = core_id();
+    IfxStm_CompareConfig config;
+
+    g_cpuLoadTickTicks[core] = (uint32)IfxStm_getTicksFromMilliseconds(g_cpuLoadStm[core], CPU_LOAD_WINDOW_MS);
+
+    IfxStm_initCompareConfig(&config);
+    config.comparator = IfxStm_Comparator_1;
+    config.comparatorInterrupt = IfxStm_ComparatorInterrupt_ir1;
+    config.ticks = g_cpuLoadTickTicks[core];
+    config.triggerPriority = ISR_PRIORITY_CPU_LOAD_TICK;
+    config.typeOfService = g_cpuLoadTos[core];
+    IfxStm_initCompare(g_cpuLoadStm[core], &config);
+}
+
+/* Idle work of every core once its window has passed, the report core writes the loads every CPU_LOAD_HISTORY */
+static void closeCpuLoadWindow(void)
+{
+    updateCpuLoad();
+    if(core_id() == CPU_LOAD_REPORT_CORE && (++g_cpuLoadReportWindows % CPU_LOAD_HISTORY) == 0)
+    {
+        /* Writing into the UART FIFO is all that is done here, sending the bytes is done by the ISRs */
+        formatCpuLoad(g_cpuLoadReport, CPU_LOAD_REPORT_SIZE);
+#if USE_LOCKS
+        GetLock();                                          /* The other cores write to VCOM under the same lock    */
+#endif
+        VCOM_Core_Write(g_cpuLoadReport);
+#if USE_LOCKS
+        ReleaseLock();
+#endif
+    }
+}
+
+/* Background loop of a core once its work is done, never returns */
+void runCpuLoadIdleLoop(void)
+{
+    initIdle();
+    registerIdleWork(isCpuLoadWindowOver, closeCpuLoadWindow);
+    startCpuLoadTick();
+    runIdleLoop();
+}
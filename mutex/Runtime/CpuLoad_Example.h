@@ -0,0 +1,38 @@
+/**********************************************************************************************************************
+ * \file CpuLoad_Example.h
+ * \brief Load accounting of the three cores of the example, streamed over the VCOM UART.
+ *
+ * Every core calls initCpuLoadExample() at the start of its main function and runCpuLoadIdleLoop() instead of its
+ * final while(1) loop. The idle loop closes the 100 ms windows of its core and core CPU_LOAD_REPORT_CORE writes the
+ * loads of all cores to the VCOM UART every second. The VCOM interrupts are accounted each in a slot of their own.
+ * The example is off by default, USE_CPU_LOAD of CpuLoad.h turns it on in the mains.
+ *
+ * The idle loop is runIdleLoop() of Idle.h, so the idle time is the time the core spends in WAIT. Closing a window is
+ * its idle work; comparator 1 of the core's STM raises an interrupt at the end of every window to end the WAIT.
+ * Comparator 0 belongs to the time-triggered executive and comparator 1 is also the thread time slice of Thread.h,
+ * whose ISR would be routed over and whose compare value would be moved, so USE_CPU_LOAD requires USE_THREAD_SLICE 0.
+ *********************************************************************************************************************/
+
+#ifndef CPULOAD_EXAMPLE_H_
+#define CPULOAD_EXAMPLE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "CpuLoad.h"
+#include "Idle.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define CPU_LOAD_REPORT_CORE        0                       /* Core serving the VCOM interrupts                     */
+#define CPU_LOAD_REPORT_SIZE        1024                    /* Bytes of the text of one report                      */
+#define ISR_PRIORITY_CPU_LOAD_TICK  4                       /* End of a window, only ends the WAIT                  */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initCpuLoadExample(void);
+void runCpuLoadIdleLoop(void);
+
+#endif /* CPULOAD_EXAMPLE_H_ */
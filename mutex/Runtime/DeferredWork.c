@@ -0,0 +1,234 @@
+/**********************************************************************************************************************
+ * \file DeferredWork.c
+ * \brief Deferred interrupt work: ISRs queue work items in O(1), a low priority worker of the chosen core runs them.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "DeferredWork.h"
+#include "Locks/per_core.h"
+#if !LOCKS_HOST
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxSrc.h"
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+#define WORK_NOW()                  cycle_count()
+#else
+#define WORK_NOW()                  IfxStm_getLower(&MODULE_STM0)
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    volatile uint32 sequence;                               /* Slot free for position n: n, filled: n + 1           */
+    WorkItem *item;
+} WorkSlot;
+
+typedef struct
+{
+    WorkSlot slot[WORK_QUEUE_LENGTH];
+    uint32 tail;                                            /* Next position to submit to, atomic                   */
+    uint32 head;                                            /* Next position to run, worker only                    */
+    WorkQueueStats stats;
+} WorkQueue;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Written by the submitting cores, so in the LMU, each queue in cache lines of its own */
+PER_CORE_SHARED(WorkQueue, g_workQueue);
+
+#if !LOCKS_HOST
+#pragma section fardata "lmudata"
+boolean g_workStarted[WORK_NUM_CORES];                      /* Work interrupt of the core started                   */
+#pragma section fardata restore
+
+static volatile Ifx_SRC_SRCR *const g_workSrc[WORK_NUM_CORES] = {&SRC_GPSR13, &SRC_GPSR14, &SRC_GPSR15};
+static const IfxSrc_Tos g_workTos[WORK_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+#endif
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Has to be called once before any item is submitted */
+void initWorkQueues(void)
+{
+    uint32 core;
+    uint32 i;
+
+    for(core = 0; core < WORK_NUM_CORES; core++)
+    {
+        WorkQueue *queue = &PER_CORE_ON(g_workQueue, core);
+
+        for(i = 0; i < WORK_QUEUE_LENGTH; i++)
+        {
+            queue->slot[i].sequence = i;
+        }
+        queue->tail = 0;
+        queue->head = 0;
+        resetWorkQueueStats(core);
+#if !LOCKS_HOST
+        g_workStarted[core] = FALSE;
+#endif
+    }
+}
+
+/* Queues the item for the worker of its core, from any core or ISR. A submission while the item is queued is
+ * coalesced and returns TRUE. FALSE if the queue is full, the submission is lost then.
+ */
+boolean submitWork(WorkItem *item)
+{
+    WorkQueue *queue = &PER_CORE_ON(g_workQueue, item->core);
+    WorkSlot *slot;
+    uint32 position;
+
+    if(swap(&item->queued, 1) != 0)
+    {
+        swap_incr(&item->coalesced);
+        return TRUE;
+    }
+    item->stamp = WORK_NOW();
+
+    /* Multi-producer ring as in ActiveObject.c: reserve a position, then mark the slot filled */
+    while(1)
+    {
+        position = queue->tail;
+        slot = &queue->slot[position & (WORK_QUEUE_LENGTH - 1)];
+        if(slot->sequence == position)
+        {
+            if(cmp_swap(&queue->tail, position, position + 1))
+            {
+                break;
+            }
+        }
+        else if((sint32)(slot->sequence - position) < 0)
+        {
+            swap_incr(&queue->stats.dropped);
+            item->queued = 0;
+            return FALSE;
+        }
+    }
+
+    slot->item = item;
+    memory_barrier();
+    slot->sequence = position + 1;
+
+#if !LOCKS_HOST
+    if(g_workStarted[item->core])
+    {
+        IfxSrc_setRequest(g_workSrc[item->core]);
+    }
+#endif
+    return TRUE;
+}
+
+/* Runs the queued items of the calling core in submission order, returns how many */
+uint32 runDeferredWork(void)
+{
+    WorkQueue *queue = &PER_CORE_THIS(g_workQueue);
+    WorkQueueStats *stats = &queue->stats;
+    uint32 count = 0;
+
+    while(1)
+    {
+        WorkSlot *slot = &queue->slot[queue->head & (WORK_QUEUE_LENGTH - 1)];
+        WorkItem *item;
+        uint32 latency;
+
+        if(slot->sequence != queue->head + 1)
+        {
+            break;
+        }
+        memory_barrier();
+        item = slot->item;
+        stats->depth = *(volatile uint32 *)&queue->tail - queue->head;
+        stats->maxDepth = (stats->depth > stats->maxDepth) ? stats->depth : stats->maxDepth;
+        slot->sequence = queue->head + WORK_QUEUE_LENGTH;   /* Free for the position one round later                */
+        queue->head++;
+
+        latency = WORK_NOW() - item->stamp;
+        memory_barrier();
+        item->queued = 0;                                   /* Submissions from now on queue the item again         */
+        memory_barrier();
+
+        item->function(item->arg);
+
+        item->runs++;
+        item->sumLatency += latency;
+        item->maxLatency = (latency > item->maxLatency) ? latency : item->maxLatency;
+        stats->runs++;
+        stats->sumLatency += latency;
+        stats->maxLatency = (latency > stats->maxLatency) ? latency : stats->maxLatency;
+        count++;
+    }
+    return count;
+}
+
+/* Statistics of the queue of a core, to be read from any core */
+const WorkQueueStats *getWorkQueueStats(uint32 core)
+{
+    return &PER_CORE_ON(g_workQueue, core).stats;
+}
+
+void resetWorkQueueStats(uint32 core)
+{
+    WorkQueueStats *stats = &PER_CORE_ON(g_workQueue, core).stats;
+
+    stats->runs = 0;
+    stats->dropped = 0;
+    stats->depth = 0;
+    stats->maxDepth = 0;
+    stats->maxLatency = 0;
+    stats->sumLatency = 0;
+}
+
+#if !LOCKS_HOST
+
+/* Work interrupt of every core: runs the queue with interrupts enabled, only lower priorities wait */
+static void workIsr(void)
+{
+    IfxCpu_enableInterrupts();
+    runDeferredWork();
+}
+
+IFX_INTERRUPT(workIsrCpu0, 0, ISR_PRIORITY_WORK);
+IFX_INTERRUPT(workIsrCpu1, 1, ISR_PRIORITY_WORK);
+IFX_INTERRUPT(workIsrCpu2, 2, ISR_PRIORITY_WORK);
+
+void workIsrCpu0(void)
+{
+    workIsr();
+}
+
+void workIsrCpu1(void)
+{
+    workIsr();
+}
+
+void workIsrCpu2(void)
+{
+    workIsr();
+}
+
+/* Makes the work interrupt of the calling core its worker, items queued before are run right away */
+void startWorkQueue(void)
+{
+    uint32 core = core_id();
+
+    IfxSrc_init(g_workSrc[core], g_workTos[core], ISR_PRIORITY_WORK);
+    IfxSrc_enable(g_workSrc[core]);
+    g_workStarted[core] = TRUE;
+    memory_barrier();
+    IfxSrc_setRequest(g_workSrc[core]);
+}
+
+#endif
@@ -0,0 +1,79 @@
+/**********************************************************************************************************************
+ * \file DeferredWork.h
+ * \brief Deferred interrupt work: ISRs queue work items in O(1), a low priority worker of the chosen core runs them.
+ *
+ * An ISR that has more to do than acknowledging its peripheral, e.g. ISR_feedback in ADC_DMA/DMA_ADC_Transfer.c
+ * writing to the UART with TIME_INFINITE, only calls submitWork() and returns. The work item names the function, its
+ * argument and the core whose worker runs it, so the work can stay on the core of the ISR or be moved to another one.
+ * Every core has one queue, a lock-free multi-producer ring, so any core and any ISR can submit.
+ *
+ * The worker of a core is either its work interrupt, a general purpose service request of priority ISR_PRIORITY_WORK
+ * raised on every submit and started with startWorkQueue(), or a call of runDeferredWork() from its background loop.
+ * The work interrupt enables interrupts while the items run, so every ISR above ISR_PRIORITY_WORK still preempts.
+ *
+ * An item is in at most one queue at a time: submitting an item that is still queued is coalesced into the queued
+ * run, which has not started yet and so sees everything the ISR wrote before. The queue of a core never overflows if
+ * it is at least as long as the number of items bound to that core. Per item the coalesced submissions and per item
+ * and queue the runs and the delay from the submission to the start of the run are kept, per queue also its depth.
+ *
+ * With LOCKS_HOST=1 there is no work interrupt, runDeferredWork() is the worker and times are in nanoseconds.
+ *********************************************************************************************************************/
+
+#ifndef DEFERREDWORK_H_
+#define DEFERREDWORK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define WORK_NUM_CORES              LOCKS_NUM_CORES
+#define WORK_QUEUE_LENGTH           32                      /* Items per core, power of two                         */
+#define ISR_PRIORITY_WORK           3                       /* Above the thread time slice, below all drivers       */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*WorkFunction)(void *arg);
+
+typedef struct
+{
+    WorkFunction function;
+    void *arg;
+    uint32 core;                                            /* Core whose worker runs the item                      */
+    uint32 queued;                                          /* 1 from the submission to the start of the run        */
+    uint32 stamp;                                           /* STM0 time of the submission that queued the item     */
+    uint32 coalesced;                                       /* Submissions while the item was queued, atomic        */
+    uint32 runs;
+    uint32 maxLatency;                                      /* Submission to start of the run in STM0 ticks         */
+    uint32 sumLatency;
+} WorkItem;
+
+#define WORK_ITEM_INIT(function, arg, core) {function, arg, core, 0, 0, 0, 0, 0, 0}
+
+typedef struct
+{
+    uint32 runs;
+    uint32 dropped;                                         /* Submissions that found the queue full, atomic        */
+    uint32 depth;                                           /* Items queued when the worker took the last one       */
+    uint32 maxDepth;
+    uint32 maxLatency;                                      /* Submission to start of the run in STM0 ticks         */
+    uint32 sumLatency;
+} WorkQueueStats;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initWorkQueues(void);
+boolean submitWork(WorkItem *item);
+uint32 runDeferredWork(void);
+const WorkQueueStats *getWorkQueueStats(uint32 core);
+void resetWorkQueueStats(uint32 core);
+#if !LOCKS_HOST
+void startWorkQueue(void);
+#endif
+
+#endif /* DEFERREDWORK_H_ */
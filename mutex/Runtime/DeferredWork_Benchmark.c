@@ -0,0 +1,178 @@
+/**********************************************************************************************************************
+ * \file DeferredWork_Benchmark.c
+ * \brief Latency of a low priority interrupt while a high priority ISR does heavy work inline or deferred.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "DeferredWork_Benchmark.h"
+#include "IfxCpu.h"
+#include "IfxSrc.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0
+#define BENCH_FEEDBACK_SRC          &SRC_GPSR23
+#define BENCH_TICK_SRC              &SRC_GPSR24
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Prototypes---------------------------------------------------*/
+/*********************************************************************************************************************/
+static void sendFeedback(void *arg);
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+volatile WorkBenchResult g_workBenchResult[WorkBenchPhase_count];
+WorkItem g_workBenchFeedback = WORK_ITEM_INIT(sendFeedback, 0, 0);
+volatile uint32 g_workBenchPhase = WorkBenchPhase_inline;
+volatile uint32 g_workBenchReady = 0;                       /* Cores 0 and 2 ready to take their interrupts         */
+volatile uint32 g_workBenchTickStamp = 0;                   /* STM0 time the tick was raised                        */
+volatile uint32 g_workBenchSendTicks = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Stands in for send_data() with TIME_INFINITE */
+static void sendFeedback(void *arg)
+{
+    uint32 start = IfxStm_getLower(BENCH_TIMER);
+
+    (void)arg;
+    while((IfxStm_getLower(BENCH_TIMER) - start) < g_workBenchSendTicks)
+    {
+    }
+    g_workBenchResult[g_workBenchPhase].completions++;
+}
+
+IFX_INTERRUPT(workBenchFeedbackIsr, 0, ISR_PRIORITY_WORK_BENCH_FEEDBACK);
+void workBenchFeedbackIsr(void)
+{
+    if(g_workBenchPhase == WorkBenchPhase_inline)
+    {
+        sendFeedback(0);
+    }
+    else
+    {
+        submitWork(&g_workBenchFeedback);
+    }
+}
+
+IFX_INTERRUPT(workBenchTickIsr, 0, ISR_PRIORITY_WORK_BENCH_TICK);
+void workBenchTickIsr(void)
+{
+    volatile WorkBenchResult *result = &g_workBenchResult[g_workBenchPhase];
+    uint32 latency = IfxStm_getLower(BENCH_TIMER) - g_workBenchTickStamp;
+
+    result->ticks++;
+    result->tickSumLatency += latency;
+    result->tickMaxLatency = (latency > result->tickMaxLatency) ? latency : result->tickMaxLatency;
+}
+
+static void waitUs(uint32 us)
+{
+    uint32 ticks = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, us);
+    uint32 start = IfxStm_getLower(BENCH_TIMER);
+
+    while((IfxStm_getLower(BENCH_TIMER) - start) < ticks)
+    {
+    }
+}
+
+void runDeferredWorkBenchmarkCore0(void)
+{
+    uint32 phase;
+
+    for(phase = 0; phase < WorkBenchPhase_count; phase++)
+    {
+        g_workBenchResult[phase].ticks = 0;
+        g_workBenchResult[phase].tickMaxLatency = 0;
+        g_workBenchResult[phase].tickSumLatency = 0;
+        g_workBenchResult[phase].completions = 0;
+    }
+    g_workBenchSendTicks = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, WORK_BENCH_SEND_US);
+
+    initWorkQueues();
+    startWorkQueue();
+    IfxSrc_init(BENCH_FEEDBACK_SRC, IfxSrc_Tos_cpu0, ISR_PRIORITY_WORK_BENCH_FEEDBACK);
+    IfxSrc_enable(BENCH_FEEDBACK_SRC);
+    IfxSrc_init(BENCH_TICK_SRC, IfxSrc_Tos_cpu0, ISR_PRIORITY_WORK_BENCH_TICK);
+    IfxSrc_enable(BENCH_TICK_SRC);
+    IfxCpu_enableInterrupts();
+    swap_incr((unsigned int *)&g_workBenchReady);
+}
+
+void runDeferredWorkBenchmarkRemote(void)
+{
+    while(g_workBenchReady == 0)
+    {
+        __nop();
+    }
+    startWorkQueue();
+    IfxCpu_enableInterrupts();
+    swap_incr((unsigned int *)&g_workBenchReady);
+}
+
+void runDeferredWorkBenchmarkDriver(void)
+{
+    uint32 feedbackPeriod = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, WORK_BENCH_FEEDBACK_PERIOD_US);
+    uint32 tickPeriod = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, WORK_BENCH_TICK_PERIOD_US);
+    uint32 phase;
+
+    while(g_workBenchReady < 2)
+    {
+        __nop();
+    }
+
+    for(phase = 0; phase < WorkBenchPhase_count; phase++)
+    {
+        volatile WorkBenchResult *result = &g_workBenchResult[phase];
+        uint32 nextFeedback;
+        uint32 nextTick;
+        uint32 feedbacks = 0;
+
+        /* The item is not queued between phases, so it may change its core */
+        g_workBenchFeedback.core = (phase == WorkBenchPhase_remote) ? WORK_BENCH_REMOTE_CORE : 0;
+        g_workBenchFeedback.coalesced = 0;
+        g_workBenchFeedback.maxLatency = 0;
+        resetWorkQueueStats(g_workBenchFeedback.core);
+        g_workBenchPhase = phase;
+
+        nextFeedback = IfxStm_getLower(BENCH_TIMER);
+        nextTick = nextFeedback;
+        while(feedbacks < WORK_BENCH_FEEDBACKS)
+        {
+            uint32 now = IfxStm_getLower(BENCH_TIMER);
+
+            if((sint32)(now - nextTick) >= 0)
+            {
+                g_workBenchTickStamp = now;
+                IfxSrc_setRequest(BENCH_TICK_SRC);
+                nextTick += tickPeriod;
+            }
+            if((sint32)(now - nextFeedback) >= 0)
+            {
+                IfxSrc_setRequest(BENCH_FEEDBACK_SRC);
+                nextFeedback += feedbackPeriod;
+                feedbacks++;
+            }
+        }
+
+        /* Let the last feedback work finish before the results are taken */
+        waitUs(4 * WORK_BENCH_SEND_US);
+        while(g_workBenchFeedback.queued != 0)
+        {
+            __nop();
+        }
+        waitUs(2 * WORK_BENCH_SEND_US);
+
+        result->coalesced = g_workBenchFeedback.coalesced;
+        result->workMaxLatency = getWorkQueueStats(g_workBenchFeedback.core)->maxLatency;
+        result->workMaxDepth = getWorkQueueStats(g_workBenchFeedback.core)->maxDepth;
+    }
+}
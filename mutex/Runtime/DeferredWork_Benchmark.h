@@ -0,0 +1,67 @@
+/**********************************************************************************************************************
+ * \file DeferredWork_Benchmark.h
+ * \brief Latency of a low priority interrupt while a high priority ISR does heavy work inline or deferred.
+ *
+ * Modelled on ISR_feedback of ADC_DMA: a "transfer done" interrupt of priority 60 on core 0 has WORK_BENCH_SEND_US of
+ * work, like send_data() waiting for the UART. Core 1 raises it every WORK_BENCH_FEEDBACK_PERIOD_US and a tick
+ * interrupt of priority 5 on core 0 every WORK_BENCH_TICK_PERIOD_US, stamping both with STM0. Three phases:
+ *  - inline: the feedback ISR does the work itself, the tick waits for it,
+ *  - deferred: the feedback ISR submits a work item run by the work interrupt of core 0 (priority 3),
+ *  - remote: the work item is bound to core 2 and run by its work interrupt.
+ * For every phase the tick latency, the feedback completions and the work queue statistics are recorded.
+ *********************************************************************************************************************/
+
+#ifndef DEFERREDWORK_BENCHMARK_H_
+#define DEFERREDWORK_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "DeferredWork.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define WORK_BENCH_FEEDBACKS            2000                /* Feedback interrupts per phase                        */
+#define WORK_BENCH_FEEDBACK_PERIOD_US   500
+#define WORK_BENCH_TICK_PERIOD_US       100
+#define WORK_BENCH_SEND_US              200                 /* Work of one feedback                                 */
+#define WORK_BENCH_REMOTE_CORE          2
+#define ISR_PRIORITY_WORK_BENCH_FEEDBACK 60
+#define ISR_PRIORITY_WORK_BENCH_TICK    5
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef enum
+{
+    WorkBenchPhase_inline,
+    WorkBenchPhase_deferred,
+    WorkBenchPhase_remote,
+    WorkBenchPhase_count
+} WorkBenchPhase;
+
+typedef struct
+{
+    uint32 ticks;                                           /* Tick interrupts taken                                */
+    uint32 tickMaxLatency;                                  /* Raise to entry of the tick ISR in STM0 ticks         */
+    uint32 tickSumLatency;
+    uint32 completions;                                     /* Feedback work done                                   */
+    uint32 coalesced;                                       /* Feedbacks merged into a queued run                   */
+    uint32 workMaxLatency;                                  /* Submission to start of the work in STM0 ticks        */
+    uint32 workMaxDepth;
+} WorkBenchResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile WorkBenchResult g_workBenchResult[WorkBenchPhase_count];
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runDeferredWorkBenchmarkCore0(void);                   /* Interrupt side, to be called on core 0               */
+void runDeferredWorkBenchmarkDriver(void);                  /* Raises the interrupts, to be called on core 1        */
+void runDeferredWorkBenchmarkRemote(void);                  /* Remote worker, to be called on core 2                */
+
+#endif /* DEFERREDWORK_BENCHMARK_H_ */
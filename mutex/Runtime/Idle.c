@@ -0,0 +1,216 @@
+/**********************************************************************************************************************
+ * \file Idle.c
+ * \brief Idle framework: a core without work waits in WAIT until an interrupt or event instead of spinning.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Idle.h"
+#include "CpuLoad.h"
+#include "Locks/per_core.h"
+#if LOCKS_HOST
+#include <sched.h>
+#else
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxSrc.h"
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+#define IDLE_NOW()                  cycle_count()
+#define idleWait()                  sched_yield()
+#else
+#define IDLE_NOW()                  IfxStm_getLower(&MODULE_STM0)
+#define idleWait()                  __asm("wait")
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    IdlePending pending[IDLE_MAX_WORK];
+    IdleRun run[IDLE_MAX_WORK];
+    uint32 count;
+    IdleStats stats;
+} IdleCore;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Only touched by its own core, the statistics are read by the others through the global DSPR address */
+PER_CORE(IdleCore, g_idle);
+
+#if !LOCKS_HOST
+static volatile Ifx_SRC_SRCR *const g_idleWakeSrc[IDLE_NUM_CORES] = {&SRC_GPSR21, &SRC_GPSR22, &SRC_GPSR25};
+static const IfxSrc_Tos g_idleWakeTos[IDLE_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+#endif
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+
+static boolean disableIdleInterrupts(void)
+{
+    return FALSE;
+}
+
+static void restoreIdleInterrupts(boolean enabled)
+{
+    (void)enabled;
+}
+
+#else
+
+static boolean disableIdleInterrupts(void)
+{
+    return IfxCpu_disableInterrupts();
+}
+
+static void restoreIdleInterrupts(boolean enabled)
+{
+    IfxCpu_restoreInterrupts(enabled);
+}
+
+/* Wake interrupt of every core: taking it is all that is needed to end the WAIT */
+IFX_INTERRUPT(idleWakeIsrCpu0, 0, ISR_PRIORITY_IDLE_WAKE);
+IFX_INTERRUPT(idleWakeIsrCpu1, 1, ISR_PRIORITY_IDLE_WAKE);
+IFX_INTERRUPT(idleWakeIsrCpu2, 2, ISR_PRIORITY_IDLE_WAKE);
+
+void idleWakeIsrCpu0(void)
+{
+    PER_CORE_THIS(g_idle).stats.wakeups++;
+}
+
+void idleWakeIsrCpu1(void)
+{
+    PER_CORE_THIS(g_idle).stats.wakeups++;
+}
+
+void idleWakeIsrCpu2(void)
+{
+    PER_CORE_THIS(g_idle).stats.wakeups++;
+}
+
+#endif
+
+/* To be called once on every core before its idle work is registered, starts the wake interrupt of the core */
+void initIdle(void)
+{
+    IdleCore *idle = &PER_CORE_THIS(g_idle);
+
+    idle->count = 0;
+    idle->stats.sleeps = 0;
+    idle->stats.sleepTicks = 0;
+    idle->stats.runs = 0;
+    idle->stats.wakeups = 0;
+#if !LOCKS_HOST
+    IfxSrc_init(g_idleWakeSrc[core_id()], g_idleWakeTos[core_id()], ISR_PRIORITY_IDLE_WAKE);
+    IfxSrc_enable(g_idleWakeSrc[core_id()]);
+#endif
+}
+
+/* Adds work to the idle loop of the calling core: run() is called whenever pending() returns TRUE. pending() is
+ * called with interrupts disabled right before WAIT, so it has to be short. FALSE if all entries are taken.
+ */
+boolean registerIdleWork(IdlePending pending, IdleRun run)
+{
+    IdleCore *idle = &PER_CORE_THIS(g_idle);
+
+    if(idle->count >= IDLE_MAX_WORK)
+    {
+        return FALSE;
+    }
+    idle->pending[idle->count] = pending;
+    idle->run[idle->count] = run;
+    idle->count++;
+    return TRUE;
+}
+
+/* Runs the pending idle work of the calling core once, TRUE if any was pending */
+boolean runIdleWork(void)
+{
+    IdleCore *idle = &PER_CORE_THIS(g_idle);
+    boolean ran = FALSE;
+    uint32 i;
+
+    for(i = 0; i < idle->count; i++)
+    {
+        if(idle->pending[i]())
+        {
+            idle->run[i]();
+            idle->stats.runs++;
+            ran = TRUE;
+        }
+    }
+    return ran;
+}
+
+/* Sleeps in WAIT until the next interrupt of the calling core unless idle work is pending. Returns after the
+ * interrupts that ended the WAIT have been taken. With USE_CPU_LOAD the time in WAIT is the idle time of the core.
+ */
+void enterIdle(void)
+{
+    IdleCore *idle = &PER_CORE_THIS(g_idle);
+    boolean interruptState = disableIdleInterrupts();
+    uint32 i;
+
+    for(i = 0; i < idle->count; i++)
+    {
+        if(idle->pending[i]())
+        {
+            restoreIdleInterrupts(interruptState);
+            return;
+        }
+    }
+
+    {
+        uint32 start = IDLE_NOW();
+
+#if USE_CPU_LOAD
+        enterCpuLoadIdle();
+#endif
+        idleWait();
+#if USE_CPU_LOAD
+        leaveCpuLoadIdle();                                 /* Before the interrupts that woke the core are taken   */
+#endif
+        idle->stats.sleepTicks += IDLE_NOW() - start;
+        idle->stats.sleeps++;
+    }
+    restoreIdleInterrupts(interruptState);
+}
+
+/* Background loop of a core with nothing else to do, replaces while(1){}. Never returns. */
+void runIdleLoop(void)
+{
+    while(1)
+    {
+        if(!runIdleWork())
+        {
+            enterIdle();
+        }
+    }
+}
+
+/* Ends the WAIT of the core, to be called from any core after writing what the core may be waiting for */
+void wakeCore(uint32 core)
+{
+#if LOCKS_HOST
+    (void)core;
+#else
+    memory_barrier();
+    IfxSrc_setRequest(g_idleWakeSrc[core]);
+#endif
+}
+
+/* Statistics of a core, to be read from any core */
+const IdleStats *getIdleStats(uint32 core)
+{
+    return &PER_CORE_ON(g_idle, core).stats;
+}
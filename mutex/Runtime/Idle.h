@@ -0,0 +1,62 @@
+/**********************************************************************************************************************
+ * \file Idle.h
+ * \brief Idle framework: a core without work waits in WAIT until an interrupt or event instead of spinning.
+ *
+ * A core spinning in while(1){} or polling a flag in the LMU keeps fetching instructions and data and competes for
+ * the SRI bus and the LMU banks with the cores doing real work. runIdleLoop() replaces those loops: it runs the idle
+ * work registered on the core (registerIdleWork) while any of it is pending and otherwise executes WAIT, which stops
+ * the core's pipeline until an interrupt request arrives for it.
+ *
+ * The pending check and WAIT are done with interrupts disabled, so a request that arrives after the check cannot be
+ * taken before WAIT and lost: WAIT returns right away for a pending request even while ICR.IE is 0, and the
+ * interrupt is taken once the interrupts are enabled again. Anything a core can be waiting for therefore has to
+ * raise an interrupt on it: peripherals and the mailbox, work queue and SST interrupts do already, for a plain flag
+ * in memory the writer calls wakeCore() after writing it. The wake interrupt of every core has priority
+ * ISR_PRIORITY_IDLE_WAKE and does nothing but end the WAIT.
+ *
+ * With LOCKS_HOST=1 WAIT is replaced by sched_yield() and wakeCore() does nothing.
+ *********************************************************************************************************************/
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define USE_IDLE                    0                       /* Opt-in: WAIT instead of while(1){} ending the mains  */
+
+#define IDLE_NUM_CORES              LOCKS_NUM_CORES
+#define IDLE_MAX_WORK               4                       /* Idle work entries per core                           */
+#define ISR_PRIORITY_IDLE_WAKE      1                       /* Lowest priority, only ends a WAIT                    */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef boolean (*IdlePending)(void);                       /* Cheap check, runs with interrupts disabled           */
+typedef void (*IdleRun)(void);
+
+typedef struct
+{
+    uint32 sleeps;                                          /* WAITs executed                                       */
+    uint32 sleepTicks;                                      /* STM0 ticks spent in WAIT, wraps                      */
+    uint32 runs;                                            /* Idle work runs                                       */
+    uint32 wakeups;                                         /* Wake interrupts taken                                */
+} IdleStats;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initIdle(void);
+boolean registerIdleWork(IdlePending pending, IdleRun run);
+boolean runIdleWork(void);
+void enterIdle(void);
+void runIdleLoop(void);
+void wakeCore(uint32 core);
+const IdleStats *getIdleStats(uint32 core);
+
+#endif /* IDLE_H_ */
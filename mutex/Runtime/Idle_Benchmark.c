@@ -0,0 +1,133 @@
+/**********************************************************************************************************************
+ * \file Idle_Benchmark.c
+ * \brief Speed of a memory-bound loop on core 0 while cores 1 and 2 poll, spin or sleep in WAIT.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Idle_Benchmark.h"
+#include "Locks/per_core.h"
+#if !LOCKS_HOST
+#include "IfxCpu.h"
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define IDLE_BENCH_HELPERS          (LOCKS_NUM_CORES - 1)
+#if LOCKS_HOST
+#define IDLE_BENCH_NOW()            cycle_count()
+#else
+#define IDLE_BENCH_NOW()            IfxStm_getLower(&MODULE_STM0)
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Mode of each helper in its own DSPR: written by core 0, spinning on it does not touch the LMU */
+PER_CORE(volatile uint32, g_idleBenchMode);
+
+#pragma section fardata "lmudata"
+volatile uint32 g_idleBenchTicks[IdleBenchMode_count];
+volatile uint32 g_idleBenchAck[LOCKS_NUM_CORES];            /* Mode a helper has entered plus one                   */
+volatile uint32 g_idleBenchFlag = 0;                        /* Polled by the helpers, never set                     */
+uint32 g_idleBenchSource[IDLE_BENCH_WORDS];
+uint32 g_idleBenchTarget[IDLE_BENCH_WORDS];
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static boolean idleBenchModeChanged(void)
+{
+    return PER_CORE_THIS(g_idleBenchMode) != IdleBenchMode_wait;
+}
+
+static void idleBenchNothing(void)
+{
+}
+
+void runIdleBenchmarkHelper(void)
+{
+    uint32 core = core_id();
+
+    initIdle();
+    registerIdleWork(idleBenchModeChanged, idleBenchNothing);
+#if !LOCKS_HOST
+    IfxCpu_enableInterrupts();
+#endif
+
+    while(1)
+    {
+        uint32 mode = PER_CORE_THIS(g_idleBenchMode);
+
+        g_idleBenchAck[core] = mode + 1;
+        if(mode == IdleBenchMode_done)
+        {
+            return;
+        }
+        while(PER_CORE_THIS(g_idleBenchMode) == mode)
+        {
+            if(mode == IdleBenchMode_poll)
+            {
+                while(g_idleBenchFlag == 0 && PER_CORE_THIS(g_idleBenchMode) == mode)
+                {
+                }
+            }
+            else if(mode == IdleBenchMode_wait)
+            {
+                enterIdle();
+            }
+        }
+    }
+}
+
+/* Switches the helpers to the mode and waits until they have entered it */
+static void setIdleBenchMode(uint32 mode)
+{
+    uint32 core;
+
+    for(core = 1; core <= IDLE_BENCH_HELPERS; core++)
+    {
+        PER_CORE_ON(g_idleBenchMode, core) = mode;
+        wakeCore(core);
+    }
+    for(core = 1; core <= IDLE_BENCH_HELPERS; core++)
+    {
+        while(g_idleBenchAck[core] != mode + 1)
+        {
+        }
+    }
+}
+
+void runIdleBenchmarkCore0(void)
+{
+    uint32 mode;
+    uint32 i;
+
+    for(i = 0; i < IDLE_BENCH_WORDS; i++)
+    {
+        g_idleBenchSource[i] = i;
+    }
+
+    for(mode = 0; mode < IdleBenchMode_count; mode++)
+    {
+        uint32 round;
+        uint32 start;
+
+        setIdleBenchMode(mode);
+        start = IDLE_BENCH_NOW();
+        for(round = 0; round < IDLE_BENCH_ROUNDS; round++)
+        {
+            for(i = 0; i < IDLE_BENCH_WORDS; i++)
+            {
+                g_idleBenchTarget[i] = g_idleBenchSource[i] + round;
+            }
+            memory_barrier();
+        }
+        g_idleBenchTicks[mode] = IDLE_BENCH_NOW() - start;
+    }
+    setIdleBenchMode(IdleBenchMode_done);
+}
@@ -0,0 +1,50 @@
+/**********************************************************************************************************************
+ * \file Idle_Benchmark.h
+ * \brief Speed of a memory-bound loop on core 0 while cores 1 and 2 poll, spin or sleep in WAIT.
+ *
+ * Core 0 copies IDLE_BENCH_WORDS words between two LMU buffers IDLE_BENCH_ROUNDS times and takes the time with STM0,
+ * once for every way cores 1 and 2 can be idle:
+ *  - poll: they read a flag in the LMU in a loop, as the WAIT_UNTIL loops on the LMU synchronisation flags do,
+ *  - spin: they run an empty loop on a variable in their own DSPR, as the while(1){} ends of CpuN_Main.c,
+ *  - wait: they are in runIdleLoop()-style WAIT and only wake for the mode change.
+ * The speed-up of the active core is g_idleBenchTicks[IdleBenchMode_poll] / g_idleBenchTicks[IdleBenchMode_wait].
+ *********************************************************************************************************************/
+
+#ifndef IDLE_BENCHMARK_H_
+#define IDLE_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Idle.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define IDLE_BENCH_WORDS            2048                    /* Words per buffer, 8 KB                               */
+#define IDLE_BENCH_ROUNDS           64
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef enum
+{
+    IdleBenchMode_poll,
+    IdleBenchMode_spin,
+    IdleBenchMode_wait,
+    IdleBenchMode_count,
+    IdleBenchMode_done = IdleBenchMode_count                /* Helpers leave the benchmark for runIdleLoop()        */
+} IdleBenchMode;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile uint32 g_idleBenchTicks[IdleBenchMode_count];   /* STM0 ticks of the copy loop on core 0            */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runIdleBenchmarkCore0(void);                           /* Memory-bound loop, to be called on core 0            */
+void runIdleBenchmarkHelper(void);                          /* Idle side, to be called on cores 1 and 2             */
+
+#endif /* IDLE_BENCHMARK_H_ */
@@ -0,0 +1,223 @@
+/**********************************************************************************************************************
+ * \file IrqRouting.c
+ * \brief Interrupt routing manager: spreads service requests over the cores by their measured ISR load.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "IrqRouting.h"
+#include "IfxStm.h"
+#include "Locks/per_core.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define IRQ_TIMER                   &MODULE_STM0            /* Shared time base of all cores                        */
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+IrqRoute *g_irqRoutes[IRQ_MAX_ROUTES];
+uint32 g_irqRouteCount = 0;
+uint32 g_irqWindowStart = 0;                                /* STM0 time the current window started                 */
+uint32 g_irqCoreWindowBusy[IRQ_NUM_CORES];                  /* g_irqCoreBusy at the start of the window             */
+uint32 g_irqCoreLoad[IRQ_NUM_CORES];                        /* ISR utilisation of the last window in permille       */
+#pragma section fardata restore
+
+/* STM ticks spent in routed ISRs per core, written by the ISRs of that core only */
+PER_CORE(uint32, g_irqCoreBusy);
+
+static const IfxSrc_Tos g_irqTos[IRQ_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static uint32 toPermille(uint32 ticks, uint32 window)
+{
+    return (window != 0) ? (uint32)(((uint64)ticks * 1000) / window) : 0;
+}
+
+/* Routes the SRC to route->core with the route priority and enables it. To be called once per route, from one core
+ * only, before balanceIrqRoutes() may run. FALSE if the registry is full or the core is not allowed.
+ */
+boolean registerIrqRoute(IrqRoute *route)
+{
+    if(g_irqRouteCount >= IRQ_MAX_ROUTES || route->core >= IRQ_NUM_CORES
+       || (route->coreMask & (1u << route->core)) == 0)
+    {
+        return FALSE;
+    }
+    route->active = 0;
+    route->windowBusyTicks = route->busyTicks;
+    g_irqRoutes[g_irqRouteCount] = route;
+    g_irqRouteCount++;
+
+    IfxSrc_init(route->src, g_irqTos[route->core], route->priority);
+    IfxSrc_enable(route->src);
+    return TRUE;
+}
+
+/* Body of the ISR of a route on every core. The ticks of routed ISRs nesting into the handler are taken out, so
+ * every tick is counted once, for the route and the core that spent it.
+ */
+void runRoutedIrq(IrqRoute *route)
+{
+    uint32 *coreBusy = &PER_CORE_THIS(g_irqCoreBusy);
+    uint32 nestedBefore = *coreBusy;
+    uint32 start = IfxStm_getLower(IRQ_TIMER);
+    uint32 ticks;
+
+    route->active = 1;
+    route->handler(route->arg);
+    ticks = IfxStm_getLower(IRQ_TIMER) - start;
+    ticks -= *coreBusy - nestedBefore;                      /* Without nested routed ISRs                           */
+
+    route->busyTicks += ticks;
+    route->count++;
+    *coreBusy += ticks;
+    memory_barrier();
+    route->active = 0;
+}
+
+/* Routes the SRC to another core without losing a request. Not to be called from an ISR of the old core with a
+ * priority above the route, the old core could never leave the handler then.
+ */
+boolean migrateIrqRoute(IrqRoute *route, uint32 core)
+{
+    volatile Ifx_SRC_SRCR *src = route->src;
+    uint32 start;
+
+    if(core >= IRQ_NUM_CORES || (route->coreMask & (1u << core)) == 0)
+    {
+        return FALSE;
+    }
+    if(core == route->core)
+    {
+        return TRUE;
+    }
+
+    IfxSrc_disable(src);                                    /* A pending request stays pending in SRR               */
+
+    /* A request the old core accepted just before is only visible in route->active once its ISR has been entered */
+    start = IfxStm_getLower(IRQ_TIMER);
+    while((IfxStm_getLower(IRQ_TIMER) - start) < IRQ_MIGRATION_SETTLE_TICKS)
+    {
+    }
+    while(route->active != 0)
+    {
+    }
+    memory_barrier();
+
+    route->core = core;
+    src->B.TOS = g_irqTos[core];
+    route->migrations++;
+    IfxSrc_enable(src);                                     /* The new core takes a pending request now             */
+    return TRUE;
+}
+
+/* Closes the measurement window and computes the loads in permille, to be called periodically from one core */
+void updateIrqLoad(void)
+{
+    uint32 now = IfxStm_getLower(IRQ_TIMER);
+    uint32 window = now - g_irqWindowStart;
+    uint32 i;
+
+    for(i = 0; i < g_irqRouteCount; i++)
+    {
+        IrqRoute *route = g_irqRoutes[i];
+        uint32 busy = route->busyTicks;
+
+        route->load = toPermille(busy - route->windowBusyTicks, window);
+        route->windowBusyTicks = busy;
+    }
+    for(i = 0; i < IRQ_NUM_CORES; i++)
+    {
+        uint32 busy = *(volatile uint32 *)&PER_CORE_ON(g_irqCoreBusy, i);
+
+        g_irqCoreLoad[i] = toPermille(busy - g_irqCoreWindowBusy[i], window);
+        g_irqCoreWindowBusy[i] = busy;
+    }
+    g_irqWindowStart = now;
+}
+
+/* Assigns the routes of the last window to the cores, heaviest first to the allowed core with the least load
+ * (longest processing time first), and migrates them if the busiest core gets at least IRQ_BALANCE_HYSTERESIS less
+ * load. Load that is not from routed ISRs is not known and counts as zero. Returns the number of migrated routes.
+ */
+uint32 balanceIrqRoutes(void)
+{
+    uint8 order[IRQ_MAX_ROUTES];
+    uint32 target[IRQ_MAX_ROUTES];
+    uint32 projected[IRQ_NUM_CORES] = {0};
+    uint32 currentMax = 0;
+    uint32 projectedMax = 0;
+    uint32 migrated = 0;
+    uint32 i;
+    uint32 j;
+
+    /* Routes by load, descending */
+    for(i = 0; i < g_irqRouteCount; i++)
+    {
+        uint32 load = g_irqRoutes[i]->load;
+
+        for(j = i; j > 0 && g_irqRoutes[order[j - 1]]->load < load; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = (uint8)i;
+    }
+
+    for(i = 0; i < g_irqRouteCount; i++)
+    {
+        IrqRoute *route = g_irqRoutes[order[i]];
+        uint32 best = route->core;
+        uint32 core;
+
+        for(core = 0; core < IRQ_NUM_CORES; core++)
+        {
+            if((route->coreMask & (1u << core)) != 0 && projected[core] < projected[best])
+            {
+                best = core;
+            }
+        }
+        target[order[i]] = best;
+        projected[best] += route->load;
+    }
+
+    for(i = 0; i < IRQ_NUM_CORES; i++)
+    {
+        currentMax = (g_irqCoreLoad[i] > currentMax) ? g_irqCoreLoad[i] : currentMax;
+        projectedMax = (projected[i] > projectedMax) ? projected[i] : projectedMax;
+    }
+    if(projectedMax + IRQ_BALANCE_HYSTERESIS > currentMax)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < g_irqRouteCount; i++)
+    {
+        if(target[i] != g_irqRoutes[i]->core && migrateIrqRoute(g_irqRoutes[i], target[i]))
+        {
+            migrated++;
+        }
+    }
+    return migrated;
+}
+
+/* ISR utilisation of the core in the last window in permille */
+uint32 getCoreIrqLoad(uint32 core)
+{
+    return g_irqCoreLoad[core];
+}
+
+uint32 getIrqRouteCount(void)
+{
+    return g_irqRouteCount;
+}
+
+IrqRoute *getIrqRoute(uint32 index)
+{
+    return (index < g_irqRouteCount) ? g_irqRoutes[index] : 0;
+}
@@ -0,0 +1,103 @@
+/**********************************************************************************************************************
+ * \file IrqRouting.h
+ * \brief Interrupt routing manager: spreads service requests over the cores by their measured ISR load.
+ *
+ * Every routed service request node (SRC) is registered once as an IrqRoute with its handler and the cores allowed
+ * to serve it. The interrupt service routine of the route is entered in the vector table of every core with the
+ * same priority (IRQ_ROUTED_ISR), so the SRC can be pointed at any core by rewriting its TOS field only. The SRC
+ * priority has to be unique in the whole system, not only on the first core, because it is used on every core.
+ *
+ * runRoutedIrq() measures the time spent in the handler with STM0, without the time of nested higher priority
+ * routed ISRs. updateIrqLoad(), called periodically from one core, turns the ticks of the last window into the load
+ * of every route and the ISR utilisation of every core in permille. balanceIrqRoutes() reassigns the routes, heaviest
+ * first, to the core with the least load and migrates them when this lowers the load of the busiest core by more
+ * than IRQ_BALANCE_HYSTERESIS.
+ *
+ * Migration keeps requests: the SRC is disabled, a pending request stays pending in SRR, the manager waits until
+ * the old core has left the ISR, rewrites TOS and enables the SRC again, so the new core takes the pending request.
+ * The data of a handler that may migrate has to be accessible from every allowed core, i.e. not in the DSPR of one.
+ *
+ * Usage, e.g. for the ASCLIN receive interrupt of VCOM.c:
+ *
+ *     IrqRoute g_vcomRxRoute = IRQ_ROUTE_INIT(vcomRxHandler, &g_ascHandle, &SRC_ASCLIN0RX, ISR_PRIORITY_VCOM_0_RX,
+ *                                             0, IRQ_CORES_ALL);
+ *     IRQ_ROUTED_ISR(vcomRxIsr, ISR_PRIORITY_VCOM_0_RX, g_vcomRxRoute)
+ *
+ * and registerIrqRoute(&g_vcomRxRoute) after the driver has initialized the SRC.
+ *********************************************************************************************************************/
+
+#ifndef IRQROUTING_H_
+#define IRQROUTING_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxSrc.h"
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define IRQ_NUM_CORES               LOCKS_NUM_CORES
+#define IRQ_MAX_ROUTES              32
+#define IRQ_CORES_ALL               ((1u << IRQ_NUM_CORES) - 1)
+#define IRQ_BALANCE_HYSTERESIS      50                      /* Minimum gain of a rebalance in permille of a core    */
+#define IRQ_MIGRATION_SETTLE_TICKS  100                     /* STM ticks from an accepted request to the ISR entry  */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*IrqHandler)(void *arg);
+
+typedef struct
+{
+    IrqHandler handler;
+    void *arg;
+    volatile Ifx_SRC_SRCR *src;
+    Ifx_Priority priority;                                  /* SRC priority, unique in the system                   */
+    uint32 core;                                            /* Core the SRC is routed to                            */
+    uint32 coreMask;                                        /* Cores allowed to serve the SRC, one bit each         */
+    volatile uint32 active;                                 /* Handler running, written by the serving core         */
+    uint32 count;                                           /* ISR runs                                             */
+    uint32 busyTicks;                                       /* STM ticks in the handler, wraps                      */
+    uint32 windowBusyTicks;                                 /* busyTicks at the start of the window                 */
+    uint32 load;                                            /* Permille of one core in the last window              */
+    uint32 migrations;
+} IrqRoute;
+
+#define IRQ_ROUTE_INIT(handler, arg, src, priority, core, coreMask) \
+    {handler, arg, src, priority, core, coreMask, 0, 0, 0, 0, 0, 0}
+
+/* Defines the interrupt service routine of a route in the vector table of every core */
+#define IRQ_ROUTED_ISR(isr, priority, route)          \
+    IFX_INTERRUPT(isr##Cpu0, 0, priority);            \
+    IFX_INTERRUPT(isr##Cpu1, 1, priority);            \
+    IFX_INTERRUPT(isr##Cpu2, 2, priority);            \
+    void isr##Cpu0(void)                              \
+    {                                                 \
+        runRoutedIrq(&(route));                       \
+    }                                                 \
+    void isr##Cpu1(void)                              \
+    {                                                 \
+        runRoutedIrq(&(route));                       \
+    }                                                 \
+    void isr##Cpu2(void)                              \
+    {                                                 \
+        runRoutedIrq(&(route));                       \
+    }
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+boolean registerIrqRoute(IrqRoute *route);
+void runRoutedIrq(IrqRoute *route);
+boolean migrateIrqRoute(IrqRoute *route, uint32 core);
+void updateIrqLoad(void);
+uint32 balanceIrqRoutes(void);
+uint32 getCoreIrqLoad(uint32 core);
+uint32 getIrqRouteCount(void);
+IrqRoute *getIrqRoute(uint32 index);
+
+#endif /* IRQROUTING_H_ */
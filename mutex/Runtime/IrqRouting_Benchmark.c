@@ -0,0 +1,143 @@
+/**********************************************************************************************************************
+ * \file IrqRouting_Benchmark.c
+ * \brief Per-core ISR utilisation with all interrupts on core 0, as in the examples, and after rebalancing.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "IrqRouting_Benchmark.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 periodUs;                                        /* Time between two requests                            */
+    uint32 workUs;                                          /* Time the handler spends                              */
+    uint32 periodTicks;
+    uint32 workTicks;
+    uint32 next;                                            /* STM0 time of the next request                        */
+} BenchSource;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Prototypes---------------------------------------------------*/
+/*********************************************************************************************************************/
+static void benchHandler(void *arg);
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+BenchSource g_irqBenchSource[IRQ_BENCH_SOURCES] = {
+    {100, 30, 0, 0, 0},                                     /* 30 %                                                 */
+    {200, 50, 0, 0, 0},                                     /* 25 %                                                 */
+    {50, 10, 0, 0, 0},                                      /* 20 %                                                 */
+    {400, 60, 0, 0, 0}                                      /* 15 %                                                 */
+};
+IrqRoute g_irqBenchRoute[IRQ_BENCH_SOURCES] = {
+    IRQ_ROUTE_INIT(benchHandler, &g_irqBenchSource[0], &SRC_GPSR10, ISR_PRIORITY_IRQ_BENCH_0, 0, IRQ_CORES_ALL),
+    IRQ_ROUTE_INIT(benchHandler, &g_irqBenchSource[1], &SRC_GPSR11, ISR_PRIORITY_IRQ_BENCH_0 + 1, 0, IRQ_CORES_ALL),
+    IRQ_ROUTE_INIT(benchHandler, &g_irqBenchSource[2], &SRC_GPSR12, ISR_PRIORITY_IRQ_BENCH_0 + 2, 0, IRQ_CORES_ALL),
+    IRQ_ROUTE_INIT(benchHandler, &g_irqBenchSource[3], &SRC_GPSR20, ISR_PRIORITY_IRQ_BENCH_0 + 3, 0, IRQ_CORES_ALL)
+};
+volatile IrqRoutingBenchResult g_irqRoutingBenchAllOnCore0;
+volatile IrqRoutingBenchResult g_irqRoutingBenchBalanced;
+volatile uint32 g_irqRoutingBenchMigrations = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+IRQ_ROUTED_ISR(irqBench0Isr, ISR_PRIORITY_IRQ_BENCH_0, g_irqBenchRoute[0])
+IRQ_ROUTED_ISR(irqBench1Isr, ISR_PRIORITY_IRQ_BENCH_0 + 1, g_irqBenchRoute[1])
+IRQ_ROUTED_ISR(irqBench2Isr, ISR_PRIORITY_IRQ_BENCH_0 + 2, g_irqBenchRoute[2])
+IRQ_ROUTED_ISR(irqBench3Isr, ISR_PRIORITY_IRQ_BENCH_0 + 3, g_irqBenchRoute[3])
+
+static void benchHandler(void *arg)
+{
+    BenchSource *source = (BenchSource *)arg;
+    uint32 start = IfxStm_getLower(BENCH_TIMER);
+
+    while((IfxStm_getLower(BENCH_TIMER) - start) < source->workTicks)
+    {
+    }
+}
+
+/* Raises the requests of the sources in time for one window, then closes the window */
+static void runPhase(volatile IrqRoutingBenchResult *result)
+{
+    uint32 window = (uint32)IfxStm_getTicksFromMilliseconds(BENCH_TIMER, IRQ_BENCH_WINDOW_MS);
+    uint32 start = IfxStm_getLower(BENCH_TIMER);
+    uint32 now = start;
+    uint32 i;
+
+    result->raised = 0;
+    result->lost = 0;
+    result->background = 0;
+    for(i = 0; i < IRQ_BENCH_SOURCES; i++)
+    {
+        g_irqBenchSource[i].next = start + g_irqBenchSource[i].periodTicks;
+    }
+    updateIrqLoad();                                        /* Start the window                                     */
+
+    while((now - start) < window)
+    {
+        for(i = 0; i < IRQ_BENCH_SOURCES; i++)
+        {
+            BenchSource *source = &g_irqBenchSource[i];
+
+            if((sint32)(now - source->next) >= 0)
+            {
+                if(IfxSrc_isRequested(g_irqBenchRoute[i].src))
+                {
+                    result->lost++;
+                }
+                IfxSrc_setRequest(g_irqBenchRoute[i].src);
+                result->raised++;
+                source->next += source->periodTicks;
+            }
+        }
+        result->background++;
+        now = IfxStm_getLower(BENCH_TIMER);
+    }
+
+    updateIrqLoad();
+    for(i = 0; i < IRQ_NUM_CORES; i++)
+    {
+        result->coreLoad[i] = getCoreIrqLoad(i);
+    }
+    for(i = 0; i < IRQ_BENCH_SOURCES; i++)
+    {
+        result->routeCore[i] = g_irqBenchRoute[i].core;
+    }
+}
+
+void runIrqRoutingBenchmark(void)
+{
+    uint32 i;
+
+    for(i = 0; i < IRQ_BENCH_SOURCES; i++)
+    {
+        BenchSource *source = &g_irqBenchSource[i];
+
+        source->periodTicks = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, source->periodUs);
+        source->workTicks = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, source->workUs);
+        registerIrqRoute(&g_irqBenchRoute[i]);
+    }
+
+    runPhase(&g_irqRoutingBenchAllOnCore0);
+    g_irqRoutingBenchMigrations = balanceIrqRoutes();
+    runPhase(&g_irqRoutingBenchBalanced);
+
+    for(i = 0; i < IRQ_BENCH_SOURCES; i++)
+    {
+        IfxSrc_disable(g_irqBenchRoute[i].src);
+    }
+}
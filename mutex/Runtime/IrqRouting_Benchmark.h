@@ -0,0 +1,51 @@
+/**********************************************************************************************************************
+ * \file IrqRouting_Benchmark.h
+ * \brief Per-core ISR utilisation with all interrupts on core 0, as in the examples, and after rebalancing.
+ *
+ * Four synthetic peripherals, general purpose service requests raised by the background loop of core 0 at fixed
+ * periods, have handlers that burn a fixed number of STM ticks: 30 %, 25 %, 20 % and 15 % of a core. First all are
+ * routed to core 0 like every ASCLIN, CAN and DMA interrupt of the examples, then balanceIrqRoutes() spreads them.
+ * For both phases the ISR utilisation per core, the requests raised and the requests lost because the previous one
+ * was still pending are recorded, as well as the background loop iterations left to core 0.
+ *********************************************************************************************************************/
+
+#ifndef IRQROUTING_BENCHMARK_H_
+#define IRQROUTING_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "IrqRouting.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define IRQ_BENCH_SOURCES           4
+#define IRQ_BENCH_WINDOW_MS         100                     /* Measurement window of each phase                     */
+#define ISR_PRIORITY_IRQ_BENCH_0    50                      /* Priorities 50..53, used on every core                */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 coreLoad[IRQ_NUM_CORES];                         /* ISR utilisation in permille                          */
+    uint32 routeCore[IRQ_BENCH_SOURCES];                    /* Core serving each source                             */
+    uint32 raised;                                          /* Requests raised                                      */
+    uint32 lost;                                            /* Requests raised while the previous one was pending   */
+    uint32 background;                                      /* Background loop iterations of core 0                 */
+} IrqRoutingBenchResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile IrqRoutingBenchResult g_irqRoutingBenchAllOnCore0;
+extern volatile IrqRoutingBenchResult g_irqRoutingBenchBalanced;
+extern volatile uint32 g_irqRoutingBenchMigrations;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runIrqRoutingBenchmark(void);                          /* To be called on core 0, cores 1 and 2 idle           */
+
+#endif /* IRQROUTING_BENCHMARK_H_ */
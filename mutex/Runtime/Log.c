@@ -0,0 +1,324 @@
+/**********************************************************************************************************************
+ * \file Log.c
+ * \brief Multi-core logging: per-core record buffers, merged by time stamp and written out in bulk by one core.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Log.h"
+#include "Locks/per_core.h"
+#if !LOCKS_HOST
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+#define LOG_NOW()                   cycle_count()
+#else
+#define LOG_NOW()                   IfxStm_getLower(&MODULE_STM0)
+#endif
+#define LOG_TIME_WIDTH              10                      /* Digits of the time in a line                         */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 stamp;                                           /* STM0 time of writeLog()                              */
+    const char *format;
+    LogArg arg[LOG_ARGS];
+} LogRecord;
+
+typedef struct
+{
+    LogRecord record[LOG_RECORDS];
+    volatile uint32 head;                                   /* Next record to store, written by the core only       */
+    volatile uint32 tail;                                   /* Next record to drain, written by the drain only      */
+    LogStats stats;
+} LogBuffer;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Each buffer in the DSPR of its core, storing a record stays local */
+PER_CORE(LogBuffer, g_log);
+
+#pragma section fardata "lmudata"
+LogWrite g_logWrite = 0;
+uint32 g_logTicksPerUs = 1;
+uint32 g_logMergeTicks = 0;
+char g_logText[LOG_TEXT_SIZE];                              /* Lines of the drain not yet written                   */
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+
+static boolean disableLogInterrupts(void)
+{
+    return FALSE;
+}
+
+static void restoreLogInterrupts(boolean enabled)
+{
+    (void)enabled;
+}
+
+static uint32 getLogTicksPerUs(void)
+{
+    return 1000;                                            /* cycle_count() counts nanoseconds on the host         */
+}
+
+#else
+
+static boolean disableLogInterrupts(void)
+{
+    return IfxCpu_disableInterrupts();
+}
+
+static void restoreLogInterrupts(boolean enabled)
+{
+    IfxCpu_restoreInterrupts(enabled);
+}
+
+static uint32 getLogTicksPerUs(void)
+{
+    return (uint32)(IfxStm_getFrequency(&MODULE_STM0) / 1000000);
+}
+
+#endif
+
+/* Has to be called once before any core logs, write takes the text of the drain */
+void initLog(LogWrite write)
+{
+    uint32 core;
+
+    for(core = 0; core < LOG_NUM_CORES; core++)
+    {
+        LogBuffer *log = &PER_CORE_ON(g_log, core);
+
+        log->head = 0;
+        log->tail = 0;
+        log->stats.records = 0;
+        log->stats.dropped = 0;
+        log->stats.maxDepth = 0;
+    }
+    g_logWrite = write;
+    g_logTicksPerUs = getLogTicksPerUs();
+    g_logMergeTicks = LOG_MERGE_DELAY_US * g_logTicksPerUs;
+}
+
+/* Stores a record in the buffer of the calling core, FALSE if it was full. From tasks and ISRs of any core. */
+boolean writeLog(const char *format, LogArg arg0, LogArg arg1, LogArg arg2)
+{
+    LogBuffer *log = &PER_CORE_THIS(g_log);
+    boolean interruptState = disableLogInterrupts();
+    uint32 head = log->head;
+    LogRecord *record;
+
+    if((head - log->tail) >= LOG_RECORDS)
+    {
+        log->stats.dropped++;
+        restoreLogInterrupts(interruptState);
+        return FALSE;
+    }
+
+    record = &log->record[head & (LOG_RECORDS - 1)];
+    record->stamp = LOG_NOW();
+    record->format = format;
+    record->arg[0] = arg0;
+    record->arg[1] = arg1;
+    record->arg[2] = arg2;
+    memory_barrier();                                       /* Record complete before it is published               */
+    log->head = head + 1;
+    log->stats.records++;
+
+    restoreLogInterrupts(interruptState);
+    return TRUE;
+}
+
+static void appendChar(char *line, uint32 *length, char c)
+{
+    if(*length < LOG_LINE_SIZE - 2)                         /* Room for the line end                                */
+    {
+        line[(*length)++] = c;
+    }
+}
+
+static void appendText(char *line, uint32 *length, const char *text)
+{
+    while(*text != 0)
+    {
+        appendChar(line, length, *text++);
+    }
+}
+
+static void appendNumber(char *line, uint32 *length, uint32 value, uint32 base, uint32 width)
+{
+    char digits[12];
+    uint32 i = 0;
+
+    do
+    {
+        uint32 digit = value % base;
+
+        digits[i++] = (char)((digit < 10) ? ('0' + digit) : ('a' + digit - 10));
+        value /= base;
+    } while(value != 0);
+    while(width > i)
+    {
+        appendChar(line, length, ' ');
+        width--;
+    }
+    while(i > 0)
+    {
+        appendChar(line, length, digits[--i]);
+    }
+}
+
+/* Formats a record as one line, returns its length */
+static uint32 formatRecord(char *line, uint32 core, const LogRecord *record)
+{
+    const char *format = record->format;
+    uint32 length = 0;
+    uint32 arg = 0;
+
+    appendNumber(line, &length, record->stamp / g_logTicksPerUs, 10, LOG_TIME_WIDTH);
+    appendText(line, &length, " c");
+    appendNumber(line, &length, core, 10, 0);
+    appendChar(line, &length, ' ');
+
+    while(*format != 0)
+    {
+        char c = *format++;
+        LogArg argument;
+        uint32 value;
+
+        if(c != '%' || *format == 0)
+        {
+            appendChar(line, &length, c);
+            continue;
+        }
+        c = *format++;
+        argument = (arg < LOG_ARGS) ? record->arg[arg] : 0;
+        value = (uint32)argument;
+        switch(c)
+        {
+            case 'u':
+                appendNumber(line, &length, value, 10, 0);
+                arg++;
+                break;
+            case 'd':
+                if((sint32)value < 0)
+                {
+                    appendChar(line, &length, '-');
+                    value = (uint32)(-(sint32)value);
+                }
+                appendNumber(line, &length, value, 10, 0);
+                arg++;
+                break;
+            case 'x':
+                appendNumber(line, &length, value, 16, 0);
+                arg++;
+                break;
+            case 's':
+                appendText(line, &length, (const char *)argument);
+                arg++;
+                break;
+            default:
+                appendChar(line, &length, c);
+                break;
+        }
+    }
+    line[length++] = '\r';
+    line[length++] = '\n';
+    return length;
+}
+
+/* Writes out the records of all cores that are at least LOG_MERGE_DELAY_US old, oldest first, and returns how many.
+ * To be called from one core only.
+ */
+uint32 drainLog(void)
+{
+    uint32 now = LOG_NOW();
+    uint32 count = 0;
+    uint32 length = 0;
+
+    while(1)
+    {
+        LogBuffer *oldest = 0;
+        uint32 oldestCore = 0;
+        uint32 oldestAge = 0;
+        uint32 core;
+
+        /* The oldest waiting record of every core is the first of its ring */
+        for(core = 0; core < LOG_NUM_CORES; core++)
+        {
+            LogBuffer *log = &PER_CORE_ON(g_log, core);
+            uint32 tail = log->tail;
+            uint32 depth = log->head - tail;
+
+            if(depth != 0)
+            {
+                uint32 age;
+
+                memory_barrier();
+                age = now - log->record[tail & (LOG_RECORDS - 1)].stamp;
+                log->stats.maxDepth = (depth > log->stats.maxDepth) ? depth : log->stats.maxDepth;
+                if((sint32)age >= (sint32)g_logMergeTicks && (oldest == 0 || age > oldestAge))
+                {
+                    oldest = log;
+                    oldestCore = core;
+                    oldestAge = age;
+                }
+            }
+        }
+        if(oldest == 0)
+        {
+            break;
+        }
+
+        if(length + LOG_LINE_SIZE > LOG_TEXT_SIZE)
+        {
+            g_logWrite(g_logText, length);
+            length = 0;
+        }
+        length += formatRecord(&g_logText[length], oldestCore, &oldest->record[oldest->tail & (LOG_RECORDS - 1)]);
+        memory_barrier();                                   /* Record read before it is handed back                 */
+        oldest->tail++;
+        count++;
+    }
+
+    if(length != 0)
+    {
+        g_logWrite(g_logText, length);
+    }
+    return count;
+}
+
+/* TRUE if any core has records waiting, e.g. as pending check of the idle work of the drain core */
+boolean hasLog(void)
+{
+    uint32 core;
+
+    for(core = 0; core < LOG_NUM_CORES; core++)
+    {
+        if(PER_CORE_ON(g_log, core).head != PER_CORE_ON(g_log, core).tail)
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Statistics of a core, to be read from any core */
+const LogStats *getLogStats(uint32 core)
+{
+    return &PER_CORE_ON(g_log, core).stats;
+}
@@ -0,0 +1,72 @@
+/**********************************************************************************************************************
+ * \file Log.h
+ * \brief Multi-core logging: per-core record buffers, merged by time stamp and written out in bulk by one core.
+ *
+ * writeLog() does not format anything. It stores the STM0 time stamp, the format string and up to LOG_ARGS
+ * arguments as one record in the buffer of the calling core, a ring in its own DSPR, and returns. No lock is shared
+ * with the other cores and nothing waits for the UART, so a record costs some tens of cycles. If the buffer is full
+ * the record is dropped and counted. The tasks and ISRs of one core share its buffer; interrupts are disabled for
+ * the few stores of a record.
+ *
+ * One core, usually the one owning the UART, calls drainLog() from its background loop. It takes the records of all
+ * cores oldest first, formats them into lines and hands them to the LogWrite function given to initLog() in blocks
+ * of up to LOG_TEXT_SIZE characters, e.g. one IfxAsclin_Asc_write() call instead of one call per byte. Only records
+ * at least LOG_MERGE_DELAY_US old are taken, so a record that another core is storing at that moment cannot be
+ * overtaken by a younger one. A line looks like
+ *
+ *       1234567 c1 adc 1 value 3071
+ *
+ * with the time in microseconds, wrapping with STM0, and the core. Formats know %u, %d, %x, %s and %%; a string
+ * argument has to stay valid until it has been drained, e.g. a literal.
+ *
+ * With LOCKS_HOST=1 time stamps are in nanoseconds.
+ *********************************************************************************************************************/
+
+#ifndef LOG_H_
+#define LOG_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define LOG_NUM_CORES               LOCKS_NUM_CORES
+#define LOG_RECORDS                 64                      /* Records per core, power of two                       */
+#define LOG_ARGS                    3
+#define LOG_TEXT_SIZE               512                     /* Characters handed to LogWrite at once                */
+#define LOG_LINE_SIZE               96                      /* Longest line, longer ones are cut                    */
+#define LOG_MERGE_DELAY_US          5
+
+#define LOG0(format)                writeLog(format, 0, 0, 0)
+#define LOG1(format, a)             writeLog(format, (LogArg)(a), 0, 0)
+#define LOG2(format, a, b)          writeLog(format, (LogArg)(a), (LogArg)(b), 0)
+#define LOG3(format, a, b, c)       writeLog(format, (LogArg)(a), (LogArg)(b), (LogArg)(c))
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*LogWrite)(const char *text, uint32 length);
+
+/* A number or, for %s, a pointer: long has the width of a pointer on TriCore (32 bits) and on a 64-bit host */
+typedef unsigned long LogArg;
+
+typedef struct
+{
+    uint32 records;                                         /* Records stored                                       */
+    uint32 dropped;                                         /* Records lost to a full buffer                        */
+    uint32 maxDepth;                                        /* Most records waiting when drained                    */
+} LogStats;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initLog(LogWrite write);
+boolean writeLog(const char *format, LogArg arg0, LogArg arg1, LogArg arg2);
+uint32 drainLog(void);
+boolean hasLog(void);
+const LogStats *getLogStats(uint32 core);
+
+#endif /* LOG_H_ */
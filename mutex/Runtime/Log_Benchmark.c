@@ -0,0 +1,129 @@
+/**********************************************************************************************************************
+ * \file Log_Benchmark.c
+ * \brief Cost of a log line on the calling core: per-core log records compared to VCOM_Core_Write() under the lock.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Log_Benchmark.h"
+#include "Drivers/VCOM.h"
+#include "Locks/lock_example.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0
+#define BENCH_DRAIN_CORE            0                       /* Core owning the VCOM port                            */
+#define BENCH_CYCLE_MASK            0x7FFFFFFF              /* CCNT has 31 bits                                     */
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+volatile LogBenchResult g_logBenchResult[LogBenchPhase_count][LOG_NUM_CORES];
+volatile uint32 g_logBenchReady = 0;                        /* Cores that have arrived, counts up per phase         */
+volatile uint32 g_logBenchDone = 0;                         /* Cores done with the log phase                        */
+#pragma section fardata restore
+
+/* Lines of the locked phase, formatted beforehand as the log phase formats on the drain core */
+static char *const g_logBenchLine[LOG_NUM_CORES] = {
+    "locked line of core 0\r\n",
+    "locked line of core 1\r\n",
+    "locked line of core 2\r\n"
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Hands the merged lines to the UART driver in one call, it copies them into its transmit FIFO */
+static void writeLogVcom(const char *text, uint32 length)
+{
+    Ifx_SizeT count = (Ifx_SizeT)length;
+
+    IfxAsclin_Asc_write(&g_AsclinAsc.drivers.asc0, text, &count, TIME_INFINITE);
+}
+
+static void waitAll(uint32 arrivals)
+{
+    swap_incr((unsigned int *)&g_logBenchReady);
+    while(g_logBenchReady < arrivals)
+    {
+    }
+}
+
+static void addCycles(volatile LogBenchResult *result, uint32 cycles)
+{
+    result->minCycles = (cycles < result->minCycles) ? cycles : result->minCycles;
+    result->maxCycles = (cycles > result->maxCycles) ? cycles : result->maxCycles;
+    result->sumCycles += cycles;
+    result->count++;
+}
+
+/* Writes LOG_BENCH_LINES lines in the phase, the drain core drains while it waits for the next line */
+static void runLogBenchPhase(LogBenchPhase phase)
+{
+    uint32 core = core_id();
+    volatile LogBenchResult *result = &g_logBenchResult[phase][core];
+    uint32 period = (uint32)IfxStm_getTicksFromMicroseconds(BENCH_TIMER, LOG_BENCH_PERIOD_US);
+    uint32 next = IfxStm_getLower(BENCH_TIMER);
+    uint32 line;
+
+    result->count = 0;
+    result->minCycles = 0xFFFFFFFF;
+    result->maxCycles = 0;
+    result->sumCycles = 0;
+
+    for(line = 0; line < LOG_BENCH_LINES; line++)
+    {
+        uint32 start;
+
+        while((sint32)(IfxStm_getLower(BENCH_TIMER) - next) < 0)
+        {
+            if(phase == LogBenchPhase_log && core == BENCH_DRAIN_CORE)
+            {
+                drainLog();
+            }
+        }
+        next += period;
+
+        start = cycle_count();
+        if(phase == LogBenchPhase_log)
+        {
+            LOG2("line %u of core %u", line, core);
+        }
+        else
+        {
+            GetLock();
+            VCOM_Core_Write(g_logBenchLine[core]);
+            ReleaseLock();
+        }
+        addCycles(result, (cycle_count() - start) & BENCH_CYCLE_MASK);
+    }
+}
+
+void runLogBenchmark(void)
+{
+    uint32 core = core_id();
+
+    enable_cycle_counter();
+    if(core == BENCH_DRAIN_CORE)
+    {
+        initLog(writeLogVcom);
+    }
+    waitAll(LOG_NUM_CORES);
+
+    runLogBenchPhase(LogBenchPhase_log);
+    swap_incr((unsigned int *)&g_logBenchDone);
+    if(core == BENCH_DRAIN_CORE)
+    {
+        while(g_logBenchDone < LOG_NUM_CORES || hasLog())
+        {
+            drainLog();
+        }
+    }
+    waitAll(2 * LOG_NUM_CORES);
+
+    runLogBenchPhase(LogBenchPhase_locked);
+}
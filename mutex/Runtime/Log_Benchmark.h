@@ -0,0 +1,54 @@
+/**********************************************************************************************************************
+ * \file Log_Benchmark.h
+ * \brief Cost of a log line on the calling core: per-core log records compared to VCOM_Core_Write() under the lock.
+ *
+ * Every core writes LOG_BENCH_LINES lines, one every LOG_BENCH_PERIOD_US, which stays below what the UART can send,
+ * and takes the CCNT cycles of every call:
+ *  - log: writeLog() into the buffer of the core, core 0 drains all buffers to the VCOM UART in between,
+ *  - locked: GetLock(), VCOM_Core_Write() of the formatted line and ReleaseLock(), as Core1_Actions() does.
+ * The log phase also keeps the dropped records and the deepest buffer of every core.
+ *********************************************************************************************************************/
+
+#ifndef LOG_BENCHMARK_H_
+#define LOG_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Log.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define LOG_BENCH_LINES             100                     /* Lines per core and phase                             */
+#define LOG_BENCH_PERIOD_US         10000
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef enum
+{
+    LogBenchPhase_log,
+    LogBenchPhase_locked,
+    LogBenchPhase_count
+} LogBenchPhase;
+
+typedef struct
+{
+    uint32 count;
+    uint32 minCycles;                                       /* CCNT cycles of one call on the logging core          */
+    uint32 maxCycles;
+    uint32 sumCycles;
+} LogBenchResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile LogBenchResult g_logBenchResult[LogBenchPhase_count][LOG_NUM_CORES];
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runLogBenchmark(void);                                 /* To be called on every core, core 0 drains            */
+
+#endif /* LOG_BENCHMARK_H_ */
@@ -0,0 +1,150 @@
+/**********************************************************************************************************************
+ * \file Mailbox.c
+ * \brief Inter-core mailboxes with software interrupt (GPSR) notification.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Mailbox.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Each mailbox lives in the DSPR of its receiver, the receiver's reads stay local */
+#pragma section fardata "data_cpu0"
+Mailbox g_mailboxCpu0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu1"
+Mailbox g_mailboxCpu1;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu2"
+Mailbox g_mailboxCpu2;
+#pragma section fardata restore
+
+Mailbox *const g_mailbox[MAILBOX_NUM_CORES] = {&g_mailboxCpu0, &g_mailboxCpu1, &g_mailboxCpu2};
+
+/* General purpose service request and its type of service per receiving core */
+static volatile Ifx_SRC_SRCR *const g_mailboxSrc[MAILBOX_NUM_CORES] = {&SRC_GPSR00, &SRC_GPSR01, &SRC_GPSR02};
+static const IfxSrc_Tos g_mailboxTos[MAILBOX_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* One ISR per core, each in the vector table of its core */
+IFX_INTERRUPT(mailboxIsrCpu0, 0, ISR_PRIORITY_MAILBOX);
+IFX_INTERRUPT(mailboxIsrCpu1, 1, ISR_PRIORITY_MAILBOX);
+IFX_INTERRUPT(mailboxIsrCpu2, 2, ISR_PRIORITY_MAILBOX);
+
+void mailboxIsrCpu0(void)
+{
+    pollMailbox();
+}
+
+void mailboxIsrCpu1(void)
+{
+    pollMailbox();
+}
+
+void mailboxIsrCpu2(void)
+{
+    pollMailbox();
+}
+
+/* Initializes the mailbox of the calling core and, with useInterrupt, routes its GPSR interrupt to it.
+ * Without the interrupt the core has to call pollMailbox() itself.
+ * Has to be called on the receiving core before any other core sends to it.
+ */
+void initMailbox(MailboxHandler handler, boolean useInterrupt)
+{
+    uint32 core = (uint32)IfxCpu_getCoreIndex();
+    Mailbox *mailbox = g_mailbox[core];
+    uint32 sender;
+
+    for(sender = 0; sender < MAILBOX_NUM_CORES; sender++)
+    {
+        mailbox->fromCore[sender].head = 0;
+        mailbox->fromCore[sender].tail = 0;
+    }
+    mailbox->handler = handler;
+    mailbox->received = 0;
+    mailbox->dropped = 0;
+    memory_barrier();
+
+    if(useInterrupt)
+    {
+        IfxSrc_init(g_mailboxSrc[core], g_mailboxTos[core], ISR_PRIORITY_MAILBOX);
+        IfxSrc_enable(g_mailboxSrc[core]);
+    }
+}
+
+/* Stores a copy of msg in the destination's mailbox and raises its interrupt.
+ * Returns FALSE if the ring of this sender is full or there is no such core. May be called from tasks and ISRs.
+ */
+boolean sendMailbox(uint32 destination, const MailboxMessage *msg)
+{
+    uint32 sender = (uint32)IfxCpu_getCoreIndex();
+    MailboxChannel *channel;
+    boolean interruptState;
+    uint32 head;
+
+    if(destination >= MAILBOX_NUM_CORES)
+    {
+        return FALSE;
+    }
+    channel = &g_mailbox[destination]->fromCore[sender];
+
+    /* Task and ISRs of one core share the ring of that core */
+    interruptState = IfxCpu_disableInterrupts();
+
+    head = channel->head;
+    if((head - channel->tail) >= MAILBOX_SLOTS)
+    {
+        IfxCpu_restoreInterrupts(interruptState);
+        /* All senders count in the same word */
+        swap_incr((unsigned int *)&g_mailbox[destination]->dropped);
+        return FALSE;
+    }
+
+    channel->slot[head & (MAILBOX_SLOTS - 1)] = *msg;
+    memory_barrier();                                       /* Message complete before it is published              */
+    channel->head = head + 1;
+
+    IfxCpu_restoreInterrupts(interruptState);
+
+    memory_barrier();
+    IfxSrc_setRequest(g_mailboxSrc[destination]);
+    return TRUE;
+}
+
+/* Delivers all pending messages of the calling core to its handler.
+ * Called by the mailbox ISR, or from the main loop of a core that initialized its mailbox without interrupt.
+ */
+uint32 pollMailbox(void)
+{
+    uint32 core = (uint32)IfxCpu_getCoreIndex();
+    Mailbox *mailbox = g_mailbox[core];
+    uint32 count = 0;
+    uint32 sender;
+
+    for(sender = 0; sender < MAILBOX_NUM_CORES; sender++)
+    {
+        MailboxChannel *channel = &mailbox->fromCore[sender];
+        uint32 tail = channel->tail;
+
+        while(tail != channel->head)
+        {
+            memory_barrier();
+            mailbox->handler(sender, &channel->slot[tail & (MAILBOX_SLOTS - 1)]);
+            tail++;
+            memory_barrier();                               /* Slot consumed before it is handed back               */
+            channel->tail = tail;
+            count++;
+        }
+    }
+
+    mailbox->received += count;
+    return count;
+}
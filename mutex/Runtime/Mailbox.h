@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * \file Mailbox.h
+ * \brief Inter-core mailboxes with software interrupt (GPSR) notification.
+ *
+ * Every core owns one mailbox in its local DSPR with one single-producer ring per sending core, so sending is
+ * lock-free. After a message has been stored the sender raises the general purpose service request (SRC_GPSR0x)
+ * routed to the receiving core. The receiver's ISR drains the mailbox and calls its handler; in between the
+ * receiver can sleep in mailboxWaitUntil() instead of polling a shared flag.
+ *********************************************************************************************************************/
+
+#ifndef MAILBOX_H_
+#define MAILBOX_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxSrc.h"
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define MAILBOX_NUM_CORES           LOCKS_NUM_CORES
+#define MAILBOX_SLOTS               8                       /* Messages per sender, power of two                    */
+#define MAILBOX_DATA_WORDS          3                       /* Payload words of one message                         */
+#define ISR_PRIORITY_MAILBOX        30                      /* Priority of the GPSR interrupt on every core         */
+
+/* Puts the core to sleep until the next interrupt, e.g. the mailbox interrupt */
+#define mailboxWait()               __asm("wait")
+
+/* Sleeps until condition is true. It is checked with interrupts disabled: a message arriving after the check keeps
+ * its interrupt pending, which ends the WAIT, so it cannot be missed. Not for ISRs of the mailbox priority or above.
+ */
+#define mailboxWaitUntil(condition)                                 \
+    do                                                              \
+    {                                                               \
+        boolean mailboxInterruptState = IfxCpu_disableInterrupts(); \
+        while(!(condition))                                         \
+        {                                                           \
+            mailboxWait();                                          \
+            IfxCpu_restoreInterrupts(mailboxInterruptState);        \
+            mailboxInterruptState = IfxCpu_disableInterrupts();     \
+        }                                                           \
+        IfxCpu_restoreInterrupts(mailboxInterruptState);            \
+    } while(0)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 id;                                              /* Application defined message identifier               */
+    uint32 data[MAILBOX_DATA_WORDS];                        /* Payload                                              */
+} MailboxMessage;
+
+/* Called in the receiver's mailbox ISR for every message */
+typedef void (*MailboxHandler)(uint32 sender, const MailboxMessage *msg);
+
+typedef struct
+{
+    volatile uint32 head;                                   /* Next slot to write, written by the sender only       */
+    volatile uint32 tail;                                   /* Next slot to read, written by the receiver only      */
+    MailboxMessage slot[MAILBOX_SLOTS];
+} MailboxChannel;
+
+typedef struct
+{
+    MailboxChannel fromCore[MAILBOX_NUM_CORES];             /* One ring per sending core                            */
+    MailboxHandler handler;                                 /* Application handler of the receiving core            */
+    volatile uint32 received;                               /* Number of messages handled                           */
+    volatile uint32 dropped;                                /* Messages rejected because a ring was full, atomic    */
+} Mailbox;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initMailbox(MailboxHandler handler, boolean useInterrupt);
+boolean sendMailbox(uint32 destination, const MailboxMessage *msg);
+uint32 pollMailbox(void);
+
+#endif /* MAILBOX_H_ */
@@ -0,0 +1,131 @@
+/**********************************************************************************************************************
+ * \file Mailbox_Benchmark.c
+ * \brief Message latency and receiver load of the mailbox compared to a polled global flag.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Mailbox_Benchmark.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0            /* Shared time base of all cores                        */
+#define BENCH_MSG_PING              0x50494E47              /* Message identifier of the benchmark messages         */
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+volatile MailboxBenchResult g_mailboxBenchMailbox;
+volatile MailboxBenchResult g_mailboxBenchPolled;
+volatile uint32 g_mailboxBenchPhase = 0;                    /* Receiver ready: 1 mailbox, 2 polled flag, 3 done     */
+volatile uint32 g_pollFlagSequence = 0;                     /* The polled flag, written by the sender               */
+volatile uint32 g_pollFlagStamp = 0;
+volatile uint32 g_pollFlagAck = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void resetResult(volatile MailboxBenchResult *result)
+{
+    result->count = 0;
+    result->minTicks = 0xFFFFFFFF;
+    result->maxTicks = 0;
+    result->sumTicks = 0;
+    result->busyTicks = 0;
+    result->windowTicks = 0;
+}
+
+static void addLatency(volatile MailboxBenchResult *result, uint32 sendStamp, uint32 now)
+{
+    uint32 latency = now - sendStamp;
+
+    result->minTicks = (latency < result->minTicks) ? latency : result->minTicks;
+    result->maxTicks = (latency > result->maxTicks) ? latency : result->maxTicks;
+    result->sumTicks += latency;
+    result->count++;
+}
+
+/* Runs in the mailbox ISR of the receiver */
+static void benchMailboxHandler(uint32 sender, const MailboxMessage *msg)
+{
+    uint32 now = IfxStm_getLower(BENCH_TIMER);
+
+    (void)sender;
+    if(msg->id == BENCH_MSG_PING)
+    {
+        addLatency(&g_mailboxBenchMailbox, msg->data[0], now);
+    }
+    g_mailboxBenchMailbox.busyTicks += IfxStm_getLower(BENCH_TIMER) - now;
+}
+
+void runMailboxBenchmarkSender(void)
+{
+    MailboxMessage msg;
+    uint32 i;
+
+    /* Mailbox: one message at a time, so every message measures the wake-up of a sleeping receiver */
+    while(g_mailboxBenchPhase != 1)
+    {
+    }
+    msg.id = BENCH_MSG_PING;
+    for(i = 0; i < MAILBOX_BENCH_MESSAGES; i++)
+    {
+        msg.data[0] = IfxStm_getLower(BENCH_TIMER);
+        msg.data[1] = i;
+        sendMailbox(MAILBOX_BENCH_RECEIVER, &msg);
+        while(g_mailboxBenchMailbox.count != (i + 1))
+        {
+        }
+    }
+
+    /* Polled flag: the receiver spins on g_pollFlagSequence */
+    while(g_mailboxBenchPhase != 2)
+    {
+    }
+    for(i = 1; i <= MAILBOX_BENCH_MESSAGES; i++)
+    {
+        g_pollFlagStamp = IfxStm_getLower(BENCH_TIMER);
+        memory_barrier();
+        g_pollFlagSequence = i;
+        while(g_pollFlagAck != i)
+        {
+        }
+    }
+}
+
+void runMailboxBenchmarkReceiver(void)
+{
+    uint32 start;
+    uint32 last = 0;
+
+    resetResult(&g_mailboxBenchMailbox);
+    resetResult(&g_mailboxBenchPolled);
+
+    initMailbox(benchMailboxHandler, TRUE);
+    start = IfxStm_getLower(BENCH_TIMER);
+    g_mailboxBenchPhase = 1;
+    mailboxWaitUntil(g_mailboxBenchMailbox.count >= MAILBOX_BENCH_MESSAGES);
+    g_mailboxBenchMailbox.windowTicks = IfxStm_getLower(BENCH_TIMER) - start;
+
+    start = IfxStm_getLower(BENCH_TIMER);
+    g_mailboxBenchPhase = 2;
+    while(last < MAILBOX_BENCH_MESSAGES)
+    {
+        uint32 sequence = g_pollFlagSequence;
+        if(sequence != last)
+        {
+            addLatency(&g_mailboxBenchPolled, g_pollFlagStamp, IfxStm_getLower(BENCH_TIMER));
+            last = sequence;
+            g_pollFlagAck = sequence;
+        }
+    }
+    g_mailboxBenchPolled.windowTicks = IfxStm_getLower(BENCH_TIMER) - start;
+    g_mailboxBenchPolled.busyTicks = g_mailboxBenchPolled.windowTicks;   /* The polling core never rests    */
+
+    g_mailboxBenchPhase = 3;
+}
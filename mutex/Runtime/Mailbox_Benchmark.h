@@ -0,0 +1,49 @@
+/**********************************************************************************************************************
+ * \file Mailbox_Benchmark.h
+ * \brief Message latency and receiver load of the mailbox compared to a polled global flag.
+ *
+ * Core 0 sends MAILBOX_BENCH_MESSAGES messages to core 1, first through the mailbox (core 1 sleeps in between)
+ * and then through a polled flag as g_turnLEDon in the multicore example (core 1 spins on it). Latencies are taken
+ * with the shared STM0 timer, so they are comparable between the cores.
+ *********************************************************************************************************************/
+
+#ifndef MAILBOX_BENCHMARK_H_
+#define MAILBOX_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Mailbox.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define MAILBOX_BENCH_MESSAGES      1000
+#define MAILBOX_BENCH_RECEIVER      1                       /* Core receiving the messages                          */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 count;                                           /* Messages received                                    */
+    uint32 minTicks;                                        /* Send to handler latency in STM ticks                 */
+    uint32 maxTicks;
+    uint32 sumTicks;
+    uint32 busyTicks;                                       /* STM ticks the receiver spent receiving               */
+    uint32 windowTicks;                                     /* STM ticks of the whole run, load = busy / window     */
+} MailboxBenchResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile MailboxBenchResult g_mailboxBenchMailbox;
+extern volatile MailboxBenchResult g_mailboxBenchPolled;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runMailboxBenchmarkSender(void);                       /* To be called on core 0                               */
+void runMailboxBenchmarkReceiver(void);                     /* To be called on core MAILBOX_BENCH_RECEIVER          */
+
+#endif /* MAILBOX_BENCHMARK_H_ */
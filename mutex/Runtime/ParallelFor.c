@@ -0,0 +1,203 @@
+/**********************************************************************************************************************
+ * \file ParallelFor.c
+ * \brief Fork-join parallelFor / parallelReduce over the TriCore cores.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "ParallelFor.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define PF_OFFLINE                  0                       /* Core is not in runParallelWorker()                   */
+#define PF_IDLE                     1                       /* Parked, may be claimed by a master                   */
+#define PF_CLAIMED                  2                       /* Reserved by a master that is preparing the job       */
+#define PF_RUN                      3                       /* Block assigned, to be processed                      */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    ParallelForBody forBody;
+    ParallelReduceBody reduceBody;
+    void *arg;
+    uint32 blockBegin[PF_NUM_CORES];
+    uint32 blockEnd[PF_NUM_CORES];
+    uint32 partial[PF_NUM_CORES];
+    uint32 remaining;                                       /* Helpers that have not finished their block yet       */
+} ParallelJob;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+ParallelJob g_pfJob;
+volatile uint32 g_pfState[PF_NUM_CORES];
+uint32 g_pfMaster = 0;                                      /* One fork-join at a time, taken with cmp_swap         */
+volatile uint32 g_pfStop = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void runBlock(uint32 core)
+{
+    ParallelJob *job = &g_pfJob;
+
+    if(job->reduceBody != 0)
+    {
+        job->partial[core] = job->reduceBody(job->blockBegin[core], job->blockEnd[core], job->arg);
+    }
+    else
+    {
+        job->forBody(job->blockBegin[core], job->blockEnd[core], job->arg);
+    }
+}
+
+/* Splits [begin, end) over the calling core and the helpers it can claim and returns the combined partial results.
+ * Returns FALSE, without running anything, if the job has to run serially.
+ */
+static boolean forkJoin(uint32 begin, uint32 end, ParallelForBody forBody, ParallelReduceBody reduceBody,
+                        ParallelCombine combine, void *arg, uint32 *result)
+{
+    uint32 me = core_id();
+    uint32 participant[PF_NUM_CORES];
+    uint32 participants = 1;
+    uint32 count = end - begin;
+    uint32 core;
+    uint32 i;
+
+    if(!cmp_swap(&g_pfMaster, 0, 1))
+    {
+        return FALSE;                                       /* Another core is forking right now                    */
+    }
+
+    participant[0] = me;
+    for(core = 0; core < PF_NUM_CORES; core++)
+    {
+        if(core != me && cmp_swap((unsigned int *)&g_pfState[core], PF_IDLE, PF_CLAIMED))
+        {
+            participant[participants++] = core;
+        }
+    }
+    if(participants == 1)
+    {
+        g_pfMaster = 0;
+        return FALSE;                                       /* All helpers busy or offline                          */
+    }
+
+    g_pfJob.forBody = forBody;
+    g_pfJob.reduceBody = reduceBody;
+    g_pfJob.arg = arg;
+    for(i = 0; i < participants; i++)
+    {
+        g_pfJob.blockBegin[participant[i]] = begin + (count * i) / participants;
+        g_pfJob.blockEnd[participant[i]] = begin + (count * (i + 1)) / participants;
+    }
+    g_pfJob.remaining = participants - 1;
+    memory_barrier();                                       /* Job complete before the helpers start                */
+    for(i = 1; i < participants; i++)
+    {
+        g_pfState[participant[i]] = PF_RUN;
+    }
+
+    runBlock(me);
+
+    while(*(volatile uint32 *)&g_pfJob.remaining != 0)
+    {
+        __nop();
+    }
+    memory_barrier();
+
+    if(reduceBody != 0)
+    {
+        for(i = 0; i < participants; i++)
+        {
+            *result = combine(*result, g_pfJob.partial[participant[i]]);
+        }
+    }
+
+    memory_barrier();
+    g_pfMaster = 0;
+    return TRUE;
+}
+
+/* Calls body on blocks of [begin, end) on all idle cores and returns when every block is done.
+ * Ranges shorter than minParallel run serially, choose it from the crossover point of the benchmark.
+ */
+void parallelFor(uint32 begin, uint32 end, uint32 minParallel, ParallelForBody body, void *arg)
+{
+    if((end - begin) < minParallel || !forkJoin(begin, end, body, 0, 0, arg, 0))
+    {
+        body(begin, end, arg);
+    }
+}
+
+/* Like parallelFor(), the partial results of the blocks are combined in index order */
+uint32 parallelReduce(uint32 begin, uint32 end, uint32 minParallel, ParallelReduceBody body,
+                      ParallelCombine combine, uint32 identity, void *arg)
+{
+    uint32 result = identity;
+
+    if((end - begin) < minParallel || !forkJoin(begin, end, 0, body, combine, arg, &result))
+    {
+        result = combine(identity, body(begin, end, arg));
+    }
+    return result;
+}
+
+/* Parks the calling core as helper until stopParallelWorkers() */
+void runParallelWorker(void)
+{
+    uint32 me = core_id();
+
+    g_pfState[me] = PF_IDLE;
+    while(1)
+    {
+        uint32 state = g_pfState[me];
+
+        if(state == PF_RUN)
+        {
+            memory_barrier();
+            runBlock(me);
+            memory_barrier();                               /* Results visible before the master joins              */
+            g_pfState[me] = PF_IDLE;
+            swap_add(&g_pfJob.remaining, (uint32)-1);
+        }
+        else if(state == PF_IDLE && g_pfStop)
+        {
+            if(cmp_swap((unsigned int *)&g_pfState[me], PF_IDLE, PF_OFFLINE))
+            {
+                return;
+            }
+        }
+        else
+        {
+            __nop();
+        }
+    }
+}
+
+void stopParallelWorkers(void)
+{
+    g_pfStop = 1;
+}
+
+/* Number of helper cores currently parked in runParallelWorker() or working for a master */
+uint32 getParallelWorkers(void)
+{
+    uint32 workers = 0;
+    uint32 core;
+
+    for(core = 0; core < PF_NUM_CORES; core++)
+    {
+        if(g_pfState[core] != PF_OFFLINE)
+        {
+            workers++;
+        }
+    }
+    return workers;
+}
@@ -0,0 +1,46 @@
+/**********************************************************************************************************************
+ * \file ParallelFor.h
+ * \brief Fork-join parallelFor / parallelReduce over the TriCore cores.
+ *
+ * Helper cores park in runParallelWorker(). A master core splits an index range into one contiguous block per core
+ * it could claim, runs its own block and joins the helpers. Helpers that are busy with other work are simply not
+ * claimed; if no helper is available, another master is active or the range is shorter than minParallel, the body
+ * runs serially on the calling core. Builds on a Linux host with LOCKS_HOST=1 (see Locks/host_port.h).
+ *********************************************************************************************************************/
+
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define PF_NUM_CORES                LOCKS_NUM_CORES
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Processes the indices [begin, end) */
+typedef void (*ParallelForBody)(uint32 begin, uint32 end, void *arg);
+
+/* Returns the partial result of the indices [begin, end) */
+typedef uint32 (*ParallelReduceBody)(uint32 begin, uint32 end, void *arg);
+
+/* Combines two partial results, has to be associative */
+typedef uint32 (*ParallelCombine)(uint32 a, uint32 b);
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void parallelFor(uint32 begin, uint32 end, uint32 minParallel, ParallelForBody body, void *arg);
+uint32 parallelReduce(uint32 begin, uint32 end, uint32 minParallel, ParallelReduceBody body,
+                      ParallelCombine combine, uint32 identity, void *arg);
+void runParallelWorker(void);
+void stopParallelWorkers(void);
+uint32 getParallelWorkers(void);
+
+#endif /* PARALLELFOR_H_ */
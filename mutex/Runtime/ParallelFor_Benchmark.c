@@ -0,0 +1,203 @@
+/**********************************************************************************************************************
+ * \file ParallelFor_Benchmark.c
+ * \brief Speedup of parallelFor / parallelReduce against the block size.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "ParallelFor_Benchmark.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+uint16 g_pfBenchSamples[PF_BENCH_MAX_BLOCK];                /* ADC buffer, also the source of the DMA copy          */
+uint16 g_pfBenchFiltered[PF_BENCH_MAX_BLOCK];
+uint16 g_pfBenchFilteredSerial[PF_BENCH_MAX_BLOCK];         /* Serial output the parallel filter is checked with    */
+uint16 g_pfBenchCopy[PF_BENCH_MAX_BLOCK];                   /* Destination of the DMA copy                          */
+volatile uint32 g_pfBenchFilterSerial[PF_BENCH_SIZES];
+volatile uint32 g_pfBenchFilterParallel[PF_BENCH_SIZES];
+volatile uint32 g_pfBenchChecksumSerial[PF_BENCH_SIZES];
+volatile uint32 g_pfBenchChecksumParallel[PF_BENCH_SIZES];
+volatile uint32 g_pfBenchVerifySerial[PF_BENCH_SIZES];
+volatile uint32 g_pfBenchVerifyParallel[PF_BENCH_SIZES];
+volatile uint32 g_pfBenchCrossover = 0;
+volatile uint32 g_pfBenchErrors = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* 4-tap moving average, the first samples use the ones available */
+static void filterBody(uint32 begin, uint32 end, void *arg)
+{
+    uint32 i;
+    (void)arg;
+
+    for(i = begin; i < end; i++)
+    {
+        uint32 sum = g_pfBenchSamples[i];
+        sum += (i >= 1) ? g_pfBenchSamples[i - 1] : g_pfBenchSamples[i];
+        sum += (i >= 2) ? g_pfBenchSamples[i - 2] : g_pfBenchSamples[i];
+        sum += (i >= 3) ? g_pfBenchSamples[i - 3] : g_pfBenchSamples[i];
+        g_pfBenchFiltered[i] = (uint16)(sum >> 2);
+    }
+}
+
+static uint32 checksumBody(uint32 begin, uint32 end, void *arg)
+{
+    uint32 sum = 0;
+    uint32 i;
+    (void)arg;
+
+    for(i = begin; i < end; i++)
+    {
+        sum += g_pfBenchSamples[i] * (i + 1);
+    }
+    return sum;
+}
+
+static uint32 verifyBody(uint32 begin, uint32 end, void *arg)
+{
+    uint32 mismatches = 0;
+    uint32 i;
+    (void)arg;
+
+    for(i = begin; i < end; i++)
+    {
+        if(g_pfBenchCopy[i] != g_pfBenchSamples[i])
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/* Keeps the output of the serial filter */
+static void keepFiltered(uint32 size)
+{
+    uint32 i;
+
+    for(i = 0; i < size; i++)
+    {
+        g_pfBenchFilteredSerial[i] = g_pfBenchFiltered[i];
+    }
+}
+
+/* Words of the parallel filter output differing from the serial one */
+static uint32 compareFiltered(uint32 size)
+{
+    uint32 mismatches = 0;
+    uint32 i;
+
+    for(i = 0; i < size; i++)
+    {
+        if(g_pfBenchFiltered[i] != g_pfBenchFilteredSerial[i])
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static uint32 add(uint32 a, uint32 b)
+{
+    return a + b;
+}
+
+static uint32 fastest(uint32 best, uint32 cycles)
+{
+    return (cycles < best) ? cycles : best;
+}
+
+static void runSize(uint32 index)
+{
+    uint32 size = PF_BENCH_MIN_BLOCK << index;
+    uint32 best[6] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+    uint32 serialSum = 0;
+    uint32 parallelSum = 0;
+    uint32 serialMismatches = 0;
+    uint32 parallelMismatches = 0;
+    uint32 filterMismatches = 0;
+    uint32 start;
+    uint32 repeat;
+
+    for(repeat = 0; repeat < PF_BENCH_REPEAT; repeat++)
+    {
+        /* minParallel 0 forces the fork, the serial runs call the bodies directly */
+        start = cycle_count();
+        filterBody(0, size, 0);
+        best[0] = fastest(best[0], cycle_count() - start);
+        keepFiltered(size);
+
+        start = cycle_count();
+        parallelFor(0, size, 0, filterBody, 0);
+        best[1] = fastest(best[1], cycle_count() - start);
+        filterMismatches += compareFiltered(size);
+
+        start = cycle_count();
+        serialSum = checksumBody(0, size, 0);
+        best[2] = fastest(best[2], cycle_count() - start);
+
+        start = cycle_count();
+        parallelSum = parallelReduce(0, size, 0, checksumBody, add, 0, 0);
+        best[3] = fastest(best[3], cycle_count() - start);
+
+        start = cycle_count();
+        serialMismatches = verifyBody(0, size, 0);
+        best[4] = fastest(best[4], cycle_count() - start);
+
+        start = cycle_count();
+        parallelMismatches = parallelReduce(0, size, 0, verifyBody, add, 0, 0);
+        best[5] = fastest(best[5], cycle_count() - start);
+    }
+
+    if(filterMismatches != 0 || serialSum != parallelSum || serialMismatches != parallelMismatches)
+    {
+        g_pfBenchErrors++;
+    }
+
+    g_pfBenchFilterSerial[index] = best[0];
+    g_pfBenchFilterParallel[index] = best[1];
+    g_pfBenchChecksumSerial[index] = best[2];
+    g_pfBenchChecksumParallel[index] = best[3];
+    g_pfBenchVerifySerial[index] = best[4];
+    g_pfBenchVerifyParallel[index] = best[5];
+    if(g_pfBenchCrossover == 0 && best[1] < best[0])
+    {
+        g_pfBenchCrossover = size;
+    }
+}
+
+void runParallelForBenchmark(void)
+{
+    uint32 i;
+
+    if(core_id() != 0)
+    {
+        runParallelWorker();
+        return;
+    }
+
+    for(i = 0; i < PF_BENCH_MAX_BLOCK; i++)
+    {
+        g_pfBenchSamples[i] = (uint16)((i * 2654435761u) >> 20);
+        g_pfBenchCopy[i] = g_pfBenchSamples[i];
+    }
+    g_pfBenchCopy[PF_BENCH_MAX_BLOCK / 2] ^= 1;             /* One corrupted word for the verification to find      */
+    g_pfBenchErrors = 0;
+    g_pfBenchCrossover = 0;
+
+    while(getParallelWorkers() != PF_NUM_CORES - 1)
+    {
+        __nop();
+    }
+
+    for(i = 0; i < PF_BENCH_SIZES; i++)
+    {
+        runSize(i);
+    }
+
+    stopParallelWorkers();
+}
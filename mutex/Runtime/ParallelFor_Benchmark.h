@@ -0,0 +1,45 @@
+/**********************************************************************************************************************
+ * \file ParallelFor_Benchmark.h
+ * \brief Speedup of parallelFor / parallelReduce against the block size.
+ *
+ * Three block computations are timed serially on core 0 and forked over all cores: a 4-tap moving average over an
+ * ADC sample buffer, a position-weighted checksum and the verification of a DMA copy (count of differing words).
+ * The first block size at which the forked filter is faster is the crossover point, a good minParallel value.
+ * To be called by all cores at the same time, on a Linux host with RunOnHostCores(runParallelForBenchmark, 3).
+ *********************************************************************************************************************/
+
+#ifndef PARALLELFOR_BENCHMARK_H_
+#define PARALLELFOR_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "ParallelFor.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define PF_BENCH_MIN_BLOCK          16                      /* Block sizes 16, 32, .. 4096 samples                  */
+#define PF_BENCH_SIZES              9
+#define PF_BENCH_MAX_BLOCK          (PF_BENCH_MIN_BLOCK << (PF_BENCH_SIZES - 1))
+#define PF_BENCH_REPEAT             8                       /* The fastest of these runs is reported                */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Cycles (nanoseconds on the host) per block size, index 0 = PF_BENCH_MIN_BLOCK */
+extern volatile uint32 g_pfBenchFilterSerial[PF_BENCH_SIZES];
+extern volatile uint32 g_pfBenchFilterParallel[PF_BENCH_SIZES];
+extern volatile uint32 g_pfBenchChecksumSerial[PF_BENCH_SIZES];
+extern volatile uint32 g_pfBenchChecksumParallel[PF_BENCH_SIZES];
+extern volatile uint32 g_pfBenchVerifySerial[PF_BENCH_SIZES];
+extern volatile uint32 g_pfBenchVerifyParallel[PF_BENCH_SIZES];
+extern volatile uint32 g_pfBenchCrossover;                  /* Smallest block with a speedup, 0 if none             */
+extern volatile uint32 g_pfBenchErrors;                     /* Parallel results differing from the serial ones      */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runParallelForBenchmark(void);
+
+#endif /* PARALLELFOR_BENCHMARK_H_ */
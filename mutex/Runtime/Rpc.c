@@ -0,0 +1,231 @@
+/**********************************************************************************************************************
+ * \file Rpc.c
+ * \brief Inter-core remote procedure calls with futures, carried by the mailboxes.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Rpc.h"
+#include "Locks/per_core.h"
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Replies to one caller that found its ring full, sent again before the next message is handled. At most one per
+ * outstanding call of the caller, so RPC_MAX_PENDING entries never overflow.
+ */
+typedef struct
+{
+    MailboxMessage reply[RPC_MAX_PENDING];
+    uint32 head;                                            /* Next entry to queue                                  */
+    volatile uint32 tail;                                   /* Next entry to send, read by the caller               */
+} RpcBacklog;
+
+typedef struct
+{
+    uint32 pending[RPC_NUM_CORES];                          /* Outstanding calls to every core, atomic              */
+    RpcBacklog backlog[RPC_NUM_CORES];                      /* Replies waiting for room, per caller                 */
+    MailboxHandler handler;                                 /* Application messages                                 */
+    RpcStats stats;
+} RpcCore;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+PER_CORE(RpcCore, g_rpc);
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void completeRpc(RpcFuture *future, uint32 result)
+{
+    future->result = result;
+    memory_barrier();                                       /* Result complete before it is published               */
+    future->done = 1;
+    if(future->callback != 0)
+    {
+        future->callback(future);
+    }
+}
+
+/* Sends the queued replies to the caller in order until its ring is full again */
+static void sendBacklog(RpcBacklog *backlog, uint32 caller)
+{
+    uint32 tail = backlog->tail;
+
+    while(tail != backlog->head && sendMailbox(caller, &backlog->reply[tail % RPC_MAX_PENDING]))
+    {
+        tail++;
+    }
+    backlog->tail = tail;
+}
+
+/* Mailbox handler of every core: runs requests, completes replies, passes everything else on. The ring of a caller
+ * with application messages in it can be full when its reply is due; the reply is queued and sent again whenever a
+ * message arrives. The caller frees the ring by handling the messages in it and asks for the queued replies from its
+ * handler, so they are sent even if no other message comes.
+ */
+static void rpcMailboxHandler(uint32 sender, const MailboxMessage *msg)
+{
+    uint32 core = core_id();
+    RpcCore *rpc = &PER_CORE_ON(g_rpc, core);
+    RpcBacklog *callee = &PER_CORE_ON(g_rpc, sender).backlog[core];
+    uint32 caller;
+
+    for(caller = 0; caller < RPC_NUM_CORES; caller++)
+    {
+        if(rpc->backlog[caller].tail != rpc->backlog[caller].head)
+        {
+            sendBacklog(&rpc->backlog[caller], caller);
+        }
+    }
+
+    if(msg->id == RPC_MSG_REQUEST)
+    {
+        RpcFunction function = (RpcFunction)msg->data[0];
+        RpcBacklog *backlog = &rpc->backlog[sender];
+        MailboxMessage *reply = &backlog->reply[backlog->head % RPC_MAX_PENDING];
+
+        reply->id = RPC_MSG_REPLY;
+        reply->data[0] = msg->data[2];
+        reply->data[1] = function((void *)msg->data[1]);
+        rpc->stats.served++;
+        backlog->head++;
+        memory_barrier();                                   /* Queued before the ring is found full                 */
+        sendBacklog(backlog, sender);
+        if(backlog->tail != backlog->head)
+        {
+            rpc->stats.queuedReplies++;
+        }
+    }
+    else if(msg->id == RPC_MSG_REPLY)
+    {
+        RpcFuture *future = (RpcFuture *)msg->data[0];
+
+        swap_add(&rpc->pending[sender], 0xFFFFFFFF);
+        if(future != 0)
+        {
+            completeRpc(future, msg->data[1]);
+        }
+    }
+    else if(msg->id != RPC_MSG_RESEND && rpc->handler != 0)
+    {
+        rpc->handler(sender, msg);
+    }
+
+    /* The sender has replies for this core queued: the slots handled so far are free, let it send them. If the ring
+     * towards it is full, its handler runs for those messages anyway.
+     */
+    memory_barrier();
+    if(callee->tail != *(volatile uint32 *)&callee->head)
+    {
+        MailboxMessage resend;
+
+        resend.id = RPC_MSG_RESEND;
+        sendMailbox(sender, &resend);
+    }
+}
+
+/* Initializes the mailbox of the calling core for RPCs, handler gets all other messages and may be 0.
+ * Has to be called on every core before any other core calls it, instead of initMailbox().
+ */
+void initRpc(MailboxHandler handler)
+{
+    RpcCore *rpc = &PER_CORE_THIS(g_rpc);
+    uint32 core;
+
+    for(core = 0; core < RPC_NUM_CORES; core++)
+    {
+        rpc->pending[core] = 0;
+        rpc->backlog[core].head = 0;
+        rpc->backlog[core].tail = 0;
+    }
+    rpc->handler = handler;
+    rpc->stats.calls = 0;
+    rpc->stats.refused = 0;
+    rpc->stats.served = 0;
+    rpc->stats.queuedReplies = 0;
+    initMailbox(rpcMailboxHandler, TRUE);
+}
+
+/* Runs function(arg) on the core, the result is handed back in future, which may be 0 if it is not needed.
+ * FALSE if the call was refused because RPC_MAX_PENDING calls to the core are outstanding or its ring is full.
+ * May be called from tasks and ISRs.
+ */
+boolean callRpc(uint32 core, RpcFunction function, void *arg, RpcFuture *future)
+{
+    uint32 caller = core_id();
+    RpcCore *rpc = &PER_CORE_ON(g_rpc, caller);
+    MailboxMessage msg;
+    uint32 pending;
+
+    if(future != 0)
+    {
+        future->done = 0;
+    }
+    rpc->stats.calls++;
+    if(core == caller)
+    {
+        uint32 result = function(arg);
+
+        if(future != 0)
+        {
+            completeRpc(future, result);
+        }
+        return TRUE;
+    }
+
+    do
+    {
+        pending = rpc->pending[core];
+        if(pending >= RPC_MAX_PENDING)
+        {
+            rpc->stats.refused++;
+            return FALSE;
+        }
+    } while(!cmp_swap(&rpc->pending[core], pending, pending + 1));
+
+    msg.id = RPC_MSG_REQUEST;
+    msg.data[0] = (uint32)function;
+    msg.data[1] = (uint32)arg;
+    msg.data[2] = (uint32)future;
+    if(!sendMailbox(core, &msg))
+    {
+        swap_add(&rpc->pending[core], 0xFFFFFFFF);
+        rpc->stats.refused++;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* TRUE once the result is in the future */
+boolean pollRpc(const RpcFuture *future)
+{
+    return future->done != 0;
+}
+
+/* Sleeps in WAIT until the result is in the future and returns it. Not to be called with interrupts disabled or
+ * from an ISR of the mailbox priority or above, the reply could not be taken then.
+ */
+uint32 waitRpc(const RpcFuture *future)
+{
+    /* Checking with interrupts disabled: a reply after the check keeps its interrupt pending, which ends the WAIT */
+    boolean interruptState = IfxCpu_disableInterrupts();
+
+    while(future->done == 0)
+    {
+        mailboxWait();
+        IfxCpu_restoreInterrupts(interruptState);
+        interruptState = IfxCpu_disableInterrupts();
+    }
+    IfxCpu_restoreInterrupts(interruptState);
+    memory_barrier();
+    return future->result;
+}
+
+/* Statistics of a core, to be read from any core */
+const RpcStats *getRpcStats(uint32 core)
+{
+    return &PER_CORE_ON(g_rpc, core).stats;
+}
@@ -0,0 +1,73 @@
+/**********************************************************************************************************************
+ * \file Rpc.h
+ * \brief Inter-core remote procedure calls with futures, carried by the mailboxes.
+ *
+ * callRpc(core, function, arg, future) runs function(arg) on the given core and hands its result back in the
+ * future, which the caller can poll (pollRpc), wait for (waitRpc) or give a callback. Resources bound to one core,
+ * such as the VCOM port of core 0, can so be used from the other cores without a shared lock: they call the
+ * function that uses the resource on its core instead of taking the lock on their own.
+ *
+ * Requests and replies are mailbox messages (Mailbox.h), so they travel in the per-pair rings of the mailboxes and
+ * wake the other core with its GPSR interrupt. The function runs in the mailbox ISR of the called core, the callback
+ * in the mailbox ISR of the calling core; both have to be short and must not wait for other RPCs. A core has at
+ * most RPC_MAX_PENDING calls outstanding to each other core. Application messages share the rings, so a reply can
+ * find the ring towards its caller full: it is then queued on the called core, at most one per outstanding call, and
+ * sent as soon as the caller has handled messages of that ring. Replies are never dropped. Messages that are no RPC
+ * are passed on to the handler given to initRpc().
+ *
+ * A call to the calling core itself runs the function directly.
+ *********************************************************************************************************************/
+
+#ifndef RPC_H_
+#define RPC_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Mailbox.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define RPC_NUM_CORES               MAILBOX_NUM_CORES
+#define RPC_MAX_PENDING             (MAILBOX_SLOTS / 2)     /* Outstanding calls per pair of cores                  */
+#define RPC_MSG_REQUEST             0x52504351              /* Message identifiers, "RPCQ", "RPCR" and "RPCS"       */
+#define RPC_MSG_REPLY               0x52504352
+#define RPC_MSG_RESEND              0x52504353              /* Asks the callee to send its queued replies           */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef uint32 (*RpcFunction)(void *arg);
+
+typedef struct RpcFuture RpcFuture;
+typedef void (*RpcCallback)(RpcFuture *future);
+
+struct RpcFuture
+{
+    volatile uint32 done;                                   /* 1 once the result is there                           */
+    uint32 result;                                          /* Return value of the function                         */
+    RpcCallback callback;                                   /* Run in the mailbox ISR of the caller, may be 0       */
+    void *context;                                          /* For the callback                                     */
+};
+
+#define RPC_FUTURE_INIT(callback, context) {0, 0, callback, context}
+
+typedef struct
+{
+    uint32 calls;                                           /* Calls made by the core                               */
+    uint32 refused;                                         /* Calls refused, too many outstanding or ring full     */
+    uint32 served;                                          /* Calls of other cores run on the core                 */
+    uint32 queuedReplies;                                   /* Replies that found the ring full and were queued     */
+} RpcStats;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initRpc(MailboxHandler handler);
+boolean callRpc(uint32 core, RpcFunction function, void *arg, RpcFuture *future);
+boolean pollRpc(const RpcFuture *future);
+uint32 waitRpc(const RpcFuture *future);
+const RpcStats *getRpcStats(uint32 core);
+
+#endif /* RPC_H_ */
@@ -0,0 +1,218 @@
+/**********************************************************************************************************************
+ * \file Rpc_Benchmark.c
+ * \brief Round-trip latency of remote procedure calls for every pair of cores.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Rpc_Benchmark.h"
+#include "Locks/per_core.h"
+#include "Drivers/VCOM.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0            /* Shared time base of all cores                        */
+#define BENCH_VCOM_CORE             0                       /* Core owning the VCOM port                            */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    char text[RPC_BENCH_LINE_SIZE];
+} RpcBenchLine;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Turn of every core in its own DSPR, set by an RPC of the previous core: turns 0..2 measure, 3..5 print */
+PER_CORE(volatile uint32, g_rpcBenchTurn);
+PER_CORE(RpcBenchLine, g_rpcBenchLine);
+
+#pragma section fardata "lmudata"
+volatile RpcBenchResult g_rpcBenchResult[RPC_NUM_CORES][RPC_NUM_CORES];
+volatile uint32 g_rpcBenchReady = 0;                        /* Cores that have initialized their RPCs               */
+volatile uint32 g_rpcBenchErrors = 0;                       /* Calls that returned a wrong result                   */
+volatile uint32 g_rpcBenchRefused = 0;                      /* Measured calls callRpc() refused, not timed          */
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static uint32 rpcBenchEcho(void *arg)
+{
+    return (uint32)arg;
+}
+
+static uint32 rpcBenchSetTurn(void *arg)
+{
+    PER_CORE_THIS(g_rpcBenchTurn) = (uint32)arg;
+    return 0;
+}
+
+/* Runs on core 0, the only user of the VCOM port, in its mailbox ISR. That is above the VCOM TX interrupt, so the
+ * ISR must not wait for room in the transmit FIFO: it takes what fits and returns how many characters that were.
+ */
+static uint32 rpcBenchWrite(void *arg)
+{
+    const char *text = (const char *)arg;
+    Ifx_SizeT count = 0;
+
+    while(text[count] != 0)
+    {
+        count++;
+    }
+    IfxAsclin_Asc_write(&g_AsclinAsc.drivers.asc0, text, &count, TIME_NULL);
+    return (uint32)count;
+}
+
+/* Sleeps until the previous core has handed over the turn */
+static void waitTurn(uint32 turn)
+{
+    boolean interruptState = IfxCpu_disableInterrupts();
+
+    while(PER_CORE_THIS(g_rpcBenchTurn) != turn)
+    {
+        mailboxWait();
+        IfxCpu_restoreInterrupts(interruptState);
+        interruptState = IfxCpu_disableInterrupts();
+    }
+    IfxCpu_restoreInterrupts(interruptState);
+}
+
+static void passTurn(uint32 turn)
+{
+    if(turn < 2 * RPC_NUM_CORES)
+    {
+        while(!callRpc(turn % RPC_NUM_CORES, rpcBenchSetTurn, (void *)turn, 0))
+        {
+        }
+    }
+}
+
+static void measureRoundTrips(uint32 caller, uint32 called)
+{
+    volatile RpcBenchResult *result = &g_rpcBenchResult[caller][called];
+    RpcFuture future = RPC_FUTURE_INIT(0, 0);
+    uint32 i;
+
+    result->count = 0;
+    result->minTicks = 0xFFFFFFFF;
+    result->maxTicks = 0;
+    result->sumTicks = 0;
+    for(i = 0; i < RPC_BENCH_CALLS; i++)
+    {
+        uint32 start = IfxStm_getLower(BENCH_TIMER);
+        uint32 ticks;
+
+        if(!callRpc(called, rpcBenchEcho, (void *)i, &future))
+        {
+            g_rpcBenchRefused++;                            /* Nothing to wait for                                  */
+            continue;
+        }
+        if(waitRpc(&future) != i)
+        {
+            g_rpcBenchErrors++;
+        }
+        ticks = IfxStm_getLower(BENCH_TIMER) - start;
+        result->minTicks = (ticks < result->minTicks) ? ticks : result->minTicks;
+        result->maxTicks = (ticks > result->maxTicks) ? ticks : result->maxTicks;
+        result->sumTicks += ticks;
+        result->count++;
+    }
+}
+
+static void appendText(char *buffer, uint32 *length, const char *text)
+{
+    while(*text != 0 && *length + 1 < RPC_BENCH_LINE_SIZE)
+    {
+        buffer[(*length)++] = *text++;
+    }
+    buffer[*length] = 0;
+}
+
+static void appendNumber(char *buffer, uint32 *length, uint32 value)
+{
+    char text[12];
+    uint32 i = sizeof(text) - 1;
+
+    text[i] = 0;
+    do
+    {
+        text[--i] = (char)('0' + value % 10);
+        value /= 10;
+    } while(value != 0);
+    appendText(buffer, length, &text[i]);
+}
+
+/* One line per called core, e.g. "rpc 1->0 min 98 avg 104 max 151 ticks" */
+static void printRoundTrips(uint32 caller)
+{
+    char *line = PER_CORE_THIS(g_rpcBenchLine).text;
+    const char *text = line;
+    RpcFuture future = RPC_FUTURE_INIT(0, 0);
+    uint32 length = 0;
+    uint32 called;
+
+    line[0] = 0;
+    for(called = 0; called < RPC_NUM_CORES; called++)
+    {
+        volatile RpcBenchResult *result = &g_rpcBenchResult[caller][called];
+
+        if(called == caller || result->count == 0)
+        {
+            continue;
+        }
+        appendText(line, &length, "rpc ");
+        appendNumber(line, &length, caller);
+        appendText(line, &length, "->");
+        appendNumber(line, &length, called);
+        appendText(line, &length, " min ");
+        appendNumber(line, &length, result->minTicks);
+        appendText(line, &length, " avg ");
+        appendNumber(line, &length, result->sumTicks / result->count);
+        appendText(line, &length, " max ");
+        appendNumber(line, &length, result->maxTicks);
+        appendText(line, &length, " ticks\r\n");
+    }
+
+    /* The line stays in the DSPR of the caller until core 0 has taken all of it */
+    while(*text != 0)
+    {
+        while(!callRpc(BENCH_VCOM_CORE, rpcBenchWrite, (void *)text, &future))
+        {
+        }
+        text += waitRpc(&future);
+    }
+}
+
+void runRpcBenchmark(void)
+{
+    uint32 core = core_id();
+    uint32 called;
+
+    PER_CORE_THIS(g_rpcBenchTurn) = (core == 0) ? 0 : 0xFFFFFFFF;
+    initRpc(0);
+    IfxCpu_enableInterrupts();
+    swap_incr((unsigned int *)&g_rpcBenchReady);
+    while(g_rpcBenchReady < RPC_NUM_CORES)
+    {
+    }
+
+    waitTurn(core);
+    for(called = 0; called < RPC_NUM_CORES; called++)
+    {
+        if(called != core)
+        {
+            measureRoundTrips(core, called);
+        }
+    }
+    passTurn(core + 1);
+
+    waitTurn(core + RPC_NUM_CORES);
+    printRoundTrips(core);
+    passTurn(core + RPC_NUM_CORES + 1);
+}
@@ -0,0 +1,47 @@
+/**********************************************************************************************************************
+ * \file Rpc_Benchmark.h
+ * \brief Round-trip latency of remote procedure calls for every pair of cores.
+ *
+ * The cores take turns as caller. The caller makes RPC_BENCH_CALLS calls of an empty function on each of the other
+ * cores, one at a time, and takes the time from callRpc() to the return of waitRpc() with STM0. The called core
+ * sleeps in WAIT between the calls, so every round trip includes waking it. Afterwards cores 1 and 2 print their
+ * results through RPCs to the VCOM UART driver on core 0, without the lock of lock_example.h. Every RPC takes as
+ * much of the line as fits into the transmit FIFO, the caller repeats it for the rest.
+ *********************************************************************************************************************/
+
+#ifndef RPC_BENCHMARK_H_
+#define RPC_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Rpc.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define RPC_BENCH_CALLS             1000                    /* Calls per pair of cores                              */
+#define RPC_BENCH_LINE_SIZE         128
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    uint32 count;
+    uint32 minTicks;                                        /* Round trip in STM0 ticks                             */
+    uint32 maxTicks;
+    uint32 sumTicks;
+} RpcBenchResult;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile RpcBenchResult g_rpcBenchResult[RPC_NUM_CORES][RPC_NUM_CORES];  /* [caller][called]                 */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runRpcBenchmark(void);                                 /* To be called on every core                           */
+
+#endif /* RPC_BENCHMARK_H_ */
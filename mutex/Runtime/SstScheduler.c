@@ -0,0 +1,118 @@
+/**********************************************************************************************************************
+ * \file SstScheduler.c
+ * \brief Single-stack preemptive run-to-completion scheduler on interrupt priorities (Super Simple Tasker style).
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "SstScheduler.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define SST_TIMER                   &MODULE_STM0            /* Shared time base of all cores                        */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Routes the service request of the task to its core, to be called before the first post */
+void initSstTask(SstTask *task)
+{
+    task->events = 0;
+    resetSstTaskLatency(task);
+    IfxSrc_init(task->src, task->tos, task->priority);
+    IfxSrc_enable(task->src);
+}
+
+/* Sets event bits of the task and triggers it, from any core, task or ISR. Only the post that makes the events
+ * pending stamps them, so the latency counts from the first of them.
+ */
+void postSstTask(SstTask *task, uint32 events)
+{
+    uint32 stamp = IfxStm_getLower(SST_TIMER);
+    uint32 pending;
+
+    do
+    {
+        pending = *(volatile uint32 *)&task->events;
+    } while(!cmp_swap(&task->events, pending, pending | events));
+    if(pending == 0)
+    {
+        task->postStamp = stamp;
+    }
+    memory_barrier();                                       /* Stamp visible before the request                     */
+    IfxSrc_setRequest(task->src);
+}
+
+/* Body of the task ISR: takes all pending events and runs the task with interrupts enabled, so that only tasks
+ * of a higher priority than the current CPU priority (ICR.CCPN, set to the task priority on entry) can preempt it.
+ */
+void dispatchSstTask(SstTask *task)
+{
+    uint32 postStamp = *(volatile uint32 *)&task->postStamp;
+    uint32 events;
+    uint32 latency;
+
+    /* A post after the swap stamps after it, so the stamp read before belongs to the events taken or is older: the
+     * latency can come out too high while the stamping post is between its cmp_swap and the stamp, never too low.
+     */
+    memory_barrier();
+    events = swap(&task->events, 0);
+    if(events == 0)
+    {
+        return;                                             /* Request of events already taken by the last run      */
+    }
+    latency = IfxStm_getLower(SST_TIMER) - postStamp;
+
+    task->minLatency = (latency < task->minLatency) ? latency : task->minLatency;
+    task->maxLatency = (latency > task->maxLatency) ? latency : task->maxLatency;
+    task->sumLatency += latency;
+    task->dispatches++;
+
+    IfxCpu_enableInterrupts();
+    task->function(events);
+}
+
+/* Raises the current priority of the core to ceiling, the highest priority of the tasks sharing the resource, and
+ * returns the previous one for unlockSstScheduler(). Tasks above the ceiling keep running, unlike with
+ * IfxCpu_disableInterrupts().
+ */
+uint32 lockSstScheduler(uint32 ceiling)
+{
+    boolean interruptState = IfxCpu_disableInterrupts();
+    Ifx_CPU_ICR icr;
+    uint32 previous;
+
+    icr.U = __mfcr(CPU_ICR);
+    previous = icr.B.CCPN;
+    if(ceiling > previous)
+    {
+        icr.B.CCPN = ceiling;
+        __mtcr(CPU_ICR, icr.U);
+        __isync();
+    }
+    IfxCpu_restoreInterrupts(interruptState);
+    return previous;
+}
+
+void unlockSstScheduler(uint32 previous)
+{
+    boolean interruptState = IfxCpu_disableInterrupts();
+    Ifx_CPU_ICR icr;
+
+    icr.U = __mfcr(CPU_ICR);
+    icr.B.CCPN = previous;
+    __mtcr(CPU_ICR, icr.U);
+    __isync();
+    IfxCpu_restoreInterrupts(interruptState);
+}
+
+void resetSstTaskLatency(SstTask *task)
+{
+    task->dispatches = 0;
+    task->minLatency = 0xFFFFFFFF;
+    task->maxLatency = 0;
+    task->sumLatency = 0;
+}
@@ -0,0 +1,69 @@
+/**********************************************************************************************************************
+ * \file SstScheduler.h
+ * \brief Single-stack preemptive run-to-completion scheduler on interrupt priorities (Super Simple Tasker style).
+ *
+ * Every task is a function bound to its own service request node, in general a general purpose service request
+ * (SRC_GPSRxy) routed to the core that runs the task. Posting events to a task raises its service request and the
+ * interrupt controller does the scheduling: the task runs as interrupt service routine with the SRC priority as task
+ * priority, preempts every lower priority task and is preempted by every higher one. All tasks share the stack of the
+ * core, there is no context switch code and no scheduler loop; the background loop of the core is the idle task.
+ *
+ * Usage: define the task with SST_TASK_INIT, bind it to its vector with SST_TASK_ISR using the same priority and call
+ * initSstTask() on the core of the task. Resources shared between tasks are protected with lockSstScheduler(), which
+ * raises the current priority of the core to the ceiling priority of the resource instead of disabling interrupts.
+ *
+ * The dispatch latency from the first post to the start of the task is measured with STM0 per task.
+ *********************************************************************************************************************/
+
+#ifndef SSTSCHEDULER_H_
+#define SSTSCHEDULER_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxSrc.h"
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Runs to completion, events are the bits posted since the last run */
+typedef void (*SstTaskFunction)(uint32 events);
+
+typedef struct
+{
+    SstTaskFunction function;
+    volatile Ifx_SRC_SRCR *src;                             /* Service request node triggering the task             */
+    IfxSrc_Tos tos;                                         /* Core running the task                                */
+    Ifx_Priority priority;                                  /* SRC priority, unique on the core                     */
+    uint32 events;                                          /* Pending event bits, atomic                           */
+    uint32 postStamp;                                       /* STM0 time the first pending event was posted         */
+    uint32 dispatches;
+    uint32 minLatency;                                      /* Post to start of the task in STM ticks               */
+    uint32 maxLatency;
+    uint32 sumLatency;
+} SstTask;
+
+#define SST_TASK_INIT(function, src, tos, priority) {function, src, tos, priority, 0, 0, 0, 0xFFFFFFFF, 0, 0}
+
+/* Defines the interrupt service routine of a task, priority has to be the one given to SST_TASK_INIT */
+#define SST_TASK_ISR(isr, vectabNum, priority, task)  \
+    IFX_INTERRUPT(isr, vectabNum, priority);          \
+    void isr(void)                                    \
+    {                                                 \
+        dispatchSstTask(&(task));                     \
+    }
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initSstTask(SstTask *task);
+void postSstTask(SstTask *task, uint32 events);
+void dispatchSstTask(SstTask *task);
+uint32 lockSstScheduler(uint32 ceiling);
+void unlockSstScheduler(uint32 previous);
+void resetSstTaskLatency(SstTask *task);
+
+#endif /* SSTSCHEDULER_H_ */
@@ -0,0 +1,123 @@
+/**********************************************************************************************************************
+ * \file SstScheduler_Benchmark.c
+ * \brief Worst-case dispatch latency of the SST scheduler tasks under preemption and priority ceiling locks.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "SstScheduler_Benchmark.h"
+#include "IfxStm.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define BENCH_TIMER                 &MODULE_STM0
+#define BENCH_LOW_WORK              5000                    /* Loop iterations of the low task                      */
+#define BENCH_MID_WORK              500
+#define BENCH_LOCK_WORK             200                     /* Loop iterations inside the ceiling lock              */
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Prototypes---------------------------------------------------*/
+/*********************************************************************************************************************/
+static void lowTask(uint32 events);
+static void midTask(uint32 events);
+static void highTask(uint32 events);
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+SstTask g_sstBenchLow = SST_TASK_INIT(lowTask, &SRC_GPSR03, IfxSrc_Tos_cpu0, ISR_PRIORITY_SST_LOW);
+SstTask g_sstBenchMid = SST_TASK_INIT(midTask, &SRC_GPSR04, IfxSrc_Tos_cpu0, ISR_PRIORITY_SST_MID);
+SstTask g_sstBenchHigh = SST_TASK_INIT(highTask, &SRC_GPSR05, IfxSrc_Tos_cpu0, ISR_PRIORITY_SST_HIGH);
+volatile uint32 g_sstBenchLocks = 0;
+volatile uint32 g_sstBenchPhase = 0;                        /* 1: tasks ready, 2: posting done                      */
+volatile uint32 g_sstBenchShared = 0;                       /* Resource of the mid task and the background loop     */
+volatile uint32 g_sstBenchHighRuns = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+SST_TASK_ISR(sstBenchLowIsr, 0, ISR_PRIORITY_SST_LOW, g_sstBenchLow)
+SST_TASK_ISR(sstBenchMidIsr, 0, ISR_PRIORITY_SST_MID, g_sstBenchMid)
+SST_TASK_ISR(sstBenchHighIsr, 0, ISR_PRIORITY_SST_HIGH, g_sstBenchHigh)
+
+static void work(uint32 loops)
+{
+    volatile uint32 i;
+    for(i = 0; i < loops; i++)
+    {
+    }
+}
+
+static void lowTask(uint32 events)
+{
+    (void)events;
+    work(BENCH_LOW_WORK);
+}
+
+static void midTask(uint32 events)
+{
+    (void)events;
+    work(BENCH_MID_WORK);
+    g_sstBenchShared++;
+}
+
+static void highTask(uint32 events)
+{
+    (void)events;
+    g_sstBenchHighRuns++;
+}
+
+void runSstBenchmarkTasks(void)
+{
+    initSstTask(&g_sstBenchLow);
+    initSstTask(&g_sstBenchMid);
+    initSstTask(&g_sstBenchHigh);
+    g_sstBenchPhase = 1;
+
+    /* Idle task: keeps entering the critical section shared with the mid task */
+    while(g_sstBenchPhase != 2)
+    {
+        uint32 previous = lockSstScheduler(ISR_PRIORITY_SST_MID);
+        g_sstBenchShared++;
+        work(BENCH_LOCK_WORK);
+        unlockSstScheduler(previous);
+        g_sstBenchLocks++;
+    }
+}
+
+void runSstBenchmarkPoster(void)
+{
+    uint32 random = 12345;
+    uint32 i;
+
+    while(g_sstBenchPhase != 1)
+    {
+        __nop();
+    }
+
+    for(i = 0; i < SST_BENCH_POSTS; i++)
+    {
+        uint32 start = IfxStm_getLower(BENCH_TIMER);
+
+        random = random * 1103515245 + 12345;
+        while((IfxStm_getLower(BENCH_TIMER) - start) < ((random >> 16) & 0x3FF))
+        {
+        }
+
+        postSstTask(&g_sstBenchHigh, 1);
+        if((i & 3) == 0)
+        {
+            postSstTask(&g_sstBenchMid, 1);
+        }
+        if((i & 15) == 0)
+        {
+            postSstTask(&g_sstBenchLow, 1);
+        }
+    }
+
+    g_sstBenchPhase = 2;
+}
@@ -0,0 +1,42 @@
+/**********************************************************************************************************************
+ * \file SstScheduler_Benchmark.h
+ * \brief Worst-case dispatch latency of the SST scheduler tasks under preemption and priority ceiling locks.
+ *
+ * Core 0 runs three tasks: low (priority 11, long), mid (12, medium) and high (13, short). Core 1 posts the high task
+ * at random intervals and mid and low every 4th and 16th time, while the background loop of core 0 keeps taking a
+ * ceiling lock shared with the mid task. The high task latency shows the dispatch cost while the lower tasks run,
+ * the mid task latency includes the blocking by the ceiling lock and the low task latency the preemptions.
+ * Latencies are in STM ticks, in the task structures after the run.
+ *********************************************************************************************************************/
+
+#ifndef SSTSCHEDULER_BENCHMARK_H_
+#define SSTSCHEDULER_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "SstScheduler.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define SST_BENCH_POSTS             10000                   /* Posts of the high priority task                      */
+#define ISR_PRIORITY_SST_LOW        11
+#define ISR_PRIORITY_SST_MID        12
+#define ISR_PRIORITY_SST_HIGH       13
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern SstTask g_sstBenchLow;
+extern SstTask g_sstBenchMid;
+extern SstTask g_sstBenchHigh;
+extern volatile uint32 g_sstBenchLocks;                     /* Ceiling locks taken by the background loop           */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runSstBenchmarkTasks(void);                            /* To be called on core 0                               */
+void runSstBenchmarkPoster(void);                           /* To be called on core 1                               */
+
+#endif /* SSTSCHEDULER_BENCHMARK_H_ */
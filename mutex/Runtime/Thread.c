@@ -0,0 +1,465 @@
+/**********************************************************************************************************************
+ * \file Thread.c
+ * \brief Stackful lightweight threads per core with a CSA based context switch.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Thread.h"
+#if !LOCKS_HOST
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define THREAD_PSW_IS               0x00000200              /* Interrupts stay on the current stack                 */
+#define THREAD_PSW_INIT             (0x000008FF | THREAD_PSW_IS)    /* Supervisor mode, no call depth limit         */
+#define THREAD_ICR_INIT             0x00008000              /* Interrupts enabled, current priority 0               */
+#define THREAD_PCXI_UL              0x00100000              /* Link points to an upper context                      */
+#define THREAD_LINK_MASK            0x000FFFFF              /* Segment and offset of a CSA link                     */
+
+/* Address of the context save area a PCXI/FCX link points to */
+#define THREAD_CSA_ADDRESS(link)    ((uint32 *)((((link) & 0x000F0000) << 12) | (((link) & 0x0000FFFF) << 6)))
+
+#if defined(__TASKING__)
+#define THREAD_NOINLINE             __noinline
+#else
+#define THREAD_NOINLINE             __attribute__((noinline))
+#endif
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef struct
+{
+    Thread thread[THREAD_MAX];                              /* Index 0 is the main thread of the core               */
+    uint64 stack[THREAD_MAX - 1][THREAD_STACK_SIZE / 8];
+    uint32 current;
+    Thread *exited;                                         /* Thread whose resources wait to be freed              */
+} ThreadScheduler;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Threads never leave their core, all of their data is local */
+#pragma section fardata "data_cpu0"
+ThreadScheduler g_threadsCpu0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu1"
+ThreadScheduler g_threadsCpu1;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu2"
+ThreadScheduler g_threadsCpu2;
+#pragma section fardata restore
+
+ThreadScheduler *const g_threads[THREAD_NUM_CORES] = {&g_threadsCpu0, &g_threadsCpu1, &g_threadsCpu2};
+
+#if !LOCKS_HOST && USE_THREAD_SLICE
+static Ifx_STM *const g_threadStm[THREAD_NUM_CORES] = {&MODULE_STM0, &MODULE_STM1, &MODULE_STM2};
+static volatile Ifx_SRC_SRCR *const g_threadSliceSrc[THREAD_NUM_CORES] = {&SRC_STM0SR1, &SRC_STM1SR1, &SRC_STM2SR1};
+static const IfxSrc_Tos g_threadTos[THREAD_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+static uint32 g_threadSliceTicks[THREAD_NUM_CORES];
+#endif
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+#if LOCKS_HOST
+
+static void startThread(void);
+
+static void switchThread(Thread *from, Thread *to)
+{
+    swapcontext(&from->context, &to->context);
+}
+
+static boolean prepareThread(Thread *thread, uint64 *stack)
+{
+    getcontext(&thread->context);
+    thread->context.uc_stack.ss_sp = stack;
+    thread->context.uc_stack.ss_size = THREAD_STACK_SIZE;
+    thread->context.uc_link = 0;
+    makecontext(&thread->context, startThread, 0);
+    return TRUE;
+}
+
+static void freeThreadContext(Thread *thread)
+{
+    (void)thread;
+}
+
+static uint32 disableThreadSwitch(void)
+{
+    return 0;
+}
+
+static void restoreThreadSwitch(uint32 icr)
+{
+    (void)icr;
+}
+
+static void useThreadStackForInterrupts(void)
+{
+}
+
+#else
+
+/* Has to stay a function of its own: the CALL to it saves the upper context, its RET restores the other one */
+static THREAD_NOINLINE void switchContext(uint32 *savePcxi, uint32 loadPcxi)
+{
+    __svlcx();
+    *savePcxi = __mfcr(CPU_PCXI);
+    __mtcr(CPU_PCXI, loadPcxi);
+    __isync();
+    __rslcx();
+}
+
+static void switchThread(Thread *from, Thread *to)
+{
+    switchContext(&from->pcxi, to->pcxi);
+}
+
+/* Takes a CSA from the free context list of the core, 0 if the list is exhausted. Interrupts have to be disabled */
+static uint32 allocCsa(void)
+{
+    uint32 link = __mfcr(CPU_FCX) & THREAD_LINK_MASK;
+
+    if(link == 0 || link == (__mfcr(CPU_LCX) & THREAD_LINK_MASK))
+    {
+        return 0;                                           /* Keep the reserve below LCX for the trap handlers     */
+    }
+    __mtcr(CPU_FCX, THREAD_CSA_ADDRESS(link)[0] & THREAD_LINK_MASK);
+    __isync();
+    return link;
+}
+
+/* Gives a saved CSA chain back to the free context list. Interrupts have to be disabled */
+static void freeCsaChain(uint32 head)
+{
+    uint32 last = head & THREAD_LINK_MASK;
+    uint32 next;
+
+    if(last == 0)
+    {
+        return;
+    }
+    while((next = THREAD_CSA_ADDRESS(last)[0] & THREAD_LINK_MASK) != 0)
+    {
+        last = next;
+    }
+    THREAD_CSA_ADDRESS(last)[0] = __mfcr(CPU_FCX) & THREAD_LINK_MASK;
+    __mtcr(CPU_FCX, head & THREAD_LINK_MASK);
+    __isync();
+}
+
+static void startThread(void);
+
+/* Builds the context chain the first switch to the thread restores: a lower context whose A11 is startThread and an
+ * upper context with the stack pointer at the top of the stack and the end of the chain as PCXI.
+ */
+static boolean prepareThread(Thread *thread, uint64 *stack)
+{
+    uint32 upper = allocCsa();
+    uint32 lower = (upper != 0) ? allocCsa() : 0;
+    uint32 *csa;
+    uint32 i;
+
+    if(lower == 0)
+    {
+        if(upper != 0)
+        {
+            THREAD_CSA_ADDRESS(upper)[0] = 0;               /* Single CSA, not the rest of the free list            */
+            freeCsaChain(upper);
+        }
+        return FALSE;
+    }
+
+    csa = THREAD_CSA_ADDRESS(upper);
+    for(i = 0; i < 16; i++)
+    {
+        csa[i] = 0;
+    }
+    csa[1] = THREAD_PSW_INIT;
+    csa[2] = (uint32)&stack[THREAD_STACK_SIZE / 8];         /* A10, stack grows downwards                           */
+    csa[3] = (uint32)startThread;                           /* A11                                                  */
+
+    csa = THREAD_CSA_ADDRESS(lower);
+    for(i = 0; i < 16; i++)
+    {
+        csa[i] = 0;
+    }
+    csa[0] = upper | THREAD_PCXI_UL;
+    csa[1] = (uint32)startThread;                           /* A11, the RET after RSLCX jumps here                  */
+
+    thread->pcxi = lower;
+    return TRUE;
+}
+
+static void freeThreadContext(Thread *thread)
+{
+    freeCsaChain(thread->pcxi);
+    thread->pcxi = 0;
+}
+
+static uint32 disableThreadSwitch(void)
+{
+    uint32 icr = __mfcr(CPU_ICR);
+
+    IfxCpu_disableInterrupts();
+    return icr;
+}
+
+static void restoreThreadSwitch(uint32 icr)
+{
+    __mtcr(CPU_ICR, icr);
+    __isync();
+}
+
+/* With PSW.IS set an interrupt does not switch to the shared interrupt stack. Its frame stays on the stack of the
+ * interrupted thread, where it survives a switch to another thread inside the ISR.
+ */
+static void useThreadStackForInterrupts(void)
+{
+    __mtcr(CPU_PSW, __mfcr(CPU_PSW) | THREAD_PSW_IS);
+    __isync();
+}
+
+#endif
+
+/* Continues the thread next, returns when the calling thread is resumed. Switching has to be disabled. */
+static void resumeThread(ThreadScheduler *scheduler, uint32 next, uint32 icr)
+{
+    Thread *from = &scheduler->thread[scheduler->current];
+    Thread *self;
+
+    from->icr = icr;
+    scheduler->current = next;
+    switchThread(from, &scheduler->thread[next]);
+
+    /* Running again, possibly after a time slice interrupt of another thread */
+    self = &scheduler->thread[scheduler->current];
+    self->switches++;
+    if(scheduler->exited != 0)
+    {
+        freeThreadContext(scheduler->exited);
+        scheduler->exited->state = ThreadState_free;
+        scheduler->exited = 0;
+    }
+    restoreThreadSwitch(self->icr);
+}
+
+/* Next ready thread after the current one, the current one if there is no other */
+static uint32 nextThread(ThreadScheduler *scheduler)
+{
+    uint32 next = scheduler->current;
+    uint32 i;
+
+    for(i = 0; i < THREAD_MAX; i++)
+    {
+        next = (next + 1) % THREAD_MAX;
+        if(scheduler->thread[next].state == ThreadState_ready)
+        {
+            break;
+        }
+    }
+    return next;
+}
+
+/* First code of every created thread */
+static void startThread(void)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+    Thread *self = &scheduler->thread[scheduler->current];
+
+    self->switches++;
+    if(scheduler->exited != 0)
+    {
+        freeThreadContext(scheduler->exited);
+        scheduler->exited->state = ThreadState_free;
+        scheduler->exited = 0;
+    }
+    restoreThreadSwitch(THREAD_ICR_INIT);
+
+    self->function(self->arg);
+    exitThread();
+}
+
+/* Turns the calling code into the main thread of the core, to be called once per core */
+void initThreads(void)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+    uint32 i;
+
+    for(i = 0; i < THREAD_MAX; i++)
+    {
+        scheduler->thread[i].state = ThreadState_free;
+        scheduler->thread[i].switches = 0;
+    }
+    scheduler->thread[0].state = ThreadState_ready;
+    scheduler->current = 0;
+    scheduler->exited = 0;
+    useThreadStackForInterrupts();
+}
+
+/* Creates a thread on the calling core, it runs at the next switch. 0 if no thread or context save area is free */
+Thread *createThread(ThreadFunction function, void *arg)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+    uint32 icr = disableThreadSwitch();
+    Thread *created = 0;
+    uint32 i;
+
+    for(i = 1; i < THREAD_MAX; i++)
+    {
+        Thread *thread = &scheduler->thread[i];
+
+        if(thread->state == ThreadState_free && prepareThread(thread, scheduler->stack[i - 1]))
+        {
+            thread->function = function;
+            thread->arg = arg;
+            thread->icr = THREAD_ICR_INIT;
+            thread->switches = 0;
+            thread->state = ThreadState_ready;
+            created = thread;
+            break;
+        }
+    }
+    restoreThreadSwitch(icr);
+    return created;
+}
+
+/* Lets the next ready thread of the core run */
+void yieldThread(void)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+    uint32 icr = disableThreadSwitch();
+    uint32 next = nextThread(scheduler);
+
+    if(next != scheduler->current)
+    {
+        resumeThread(scheduler, next, icr);
+    }
+    else
+    {
+        restoreThreadSwitch(icr);
+    }
+}
+
+/* Ends the calling thread, which must not be the main thread. Its stack and CSAs are freed by the next thread. */
+void exitThread(void)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+    uint32 icr = disableThreadSwitch();
+
+    scheduler->thread[scheduler->current].state = ThreadState_exited;
+    scheduler->exited = &scheduler->thread[scheduler->current];
+    resumeThread(scheduler, nextThread(scheduler), icr);
+}
+
+Thread *getCurrentThread(void)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+
+    return &scheduler->thread[scheduler->current];
+}
+
+uint32 getReadyThreads(void)
+{
+    ThreadScheduler *scheduler = g_threads[core_id()];
+    uint32 ready = 0;
+    uint32 i;
+
+    for(i = 0; i < THREAD_MAX; i++)
+    {
+        if(scheduler->thread[i].state == ThreadState_ready)
+        {
+            ready++;
+        }
+    }
+    return ready;
+}
+
+/* CSAs a switched out thread of the calling core holds for its saved call levels, 0 on the host where the register
+ * frames are on the thread stack
+ */
+uint32 getThreadCsas(const Thread *thread)
+{
+#if LOCKS_HOST
+    (void)thread;
+    return 0;
+#else
+    uint32 link = thread->pcxi & THREAD_LINK_MASK;
+    uint32 csas = 0;
+
+    while(link != 0)
+    {
+        csas++;
+        link = THREAD_CSA_ADDRESS(link)[0] & THREAD_LINK_MASK;
+    }
+    return csas;
+#endif
+}
+
+#if !LOCKS_HOST && USE_THREAD_SLICE
+
+IFX_INTERRUPT(threadSliceIsrCpu0, 0, ISR_PRIORITY_THREAD_SLICE);
+IFX_INTERRUPT(threadSliceIsrCpu1, 1, ISR_PRIORITY_THREAD_SLICE);
+IFX_INTERRUPT(threadSliceIsrCpu2, 2, ISR_PRIORITY_THREAD_SLICE);
+
+/* The interrupted thread is suspended inside the ISR and finishes it with RFE once it is resumed */
+static void sliceExpired(uint32 core)
+{
+    Ifx_STM *stm = g_threadStm[core];
+
+    IfxStm_clearCompareFlag(stm, IfxStm_Comparator_1);
+    IfxStm_increaseCompare(stm, IfxStm_Comparator_1, g_threadSliceTicks[core]);
+    yieldThread();
+}
+
+void threadSliceIsrCpu0(void)
+{
+    sliceExpired(0);
+}
+
+void threadSliceIsrCpu1(void)
+{
+    sliceExpired(1);
+}
+
+void threadSliceIsrCpu2(void)
+{
+    sliceExpired(2);
+}
+
+/* Switches the threads of the calling core every sliceUs microseconds in addition to their yields */
+void startThreadPreemption(uint32 sliceUs)
+{
+    uint32 core = (uint32)IfxCpu_getCoreIndex();
+    Ifx_STM *stm = g_threadStm[core];
+    IfxStm_CompareConfig config;
+
+    g_threadSliceTicks[core] = (uint32)IfxStm_getTicksFromMicroseconds(stm, sliceUs);
+
+    IfxStm_initCompareConfig(&config);
+    config.comparator = IfxStm_Comparator_1;
+    config.comparatorInterrupt = IfxStm_ComparatorInterrupt_ir1;
+    config.ticks = g_threadSliceTicks[core];
+    config.triggerPriority = ISR_PRIORITY_THREAD_SLICE;
+    config.typeOfService = g_threadTos[core];
+    IfxStm_initCompare(stm, &config);
+}
+
+void stopThreadPreemption(void)
+{
+    uint32 core = (uint32)IfxCpu_getCoreIndex();
+
+    IfxSrc_disable(g_threadSliceSrc[core]);
+}
+
+#endif
@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * \file Thread.h
+ * \brief Stackful lightweight threads per core with a CSA based context switch.
+ *
+ * For nested blocking code that cannot be turned into coroutines. Every core has its own scheduler: the code calling
+ * initThreads() becomes the main thread, createThread() takes a thread and its stack from the static pool of the
+ * core. Threads switch round robin on yieldThread() and, optionally, on a time slice interrupt of the core's STM
+ * (comparator 1, comparator 0 is left to the time-triggered executive). The CPU load example needs comparator 1 as
+ * well, so USE_THREAD_SLICE has to be 0 to build it.
+ *
+ * The context of a TriCore thread is its chain of context save areas: the upper context with the stack pointer is
+ * saved by the CALL to the switch function, the lower context with SVLCX. Switching is storing PCXI of the old
+ * thread and loading PCXI of the new one, followed by RSLCX and RET. ICR is saved per thread, so a thread suspended
+ * in the time slice interrupt and one suspended in yieldThread() can resume each other. Threads stay on their core,
+ * their CSAs belong to it. Threads, the main thread included, run with PSW.IS set: interrupts use the stack of the
+ * thread they interrupt instead of the shared interrupt stack, so every stack needs room for the ISR locals.
+ *
+ * With LOCKS_HOST=1 the switch uses ucontext (swapcontext) and there is no time slice preemption.
+ *********************************************************************************************************************/
+
+#ifndef THREAD_H_
+#define THREAD_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+#if LOCKS_HOST
+#include <ucontext.h>
+#endif
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define USE_THREAD_SLICE            1                       /* Time slice on STM comparator 1, see CpuLoad_Example  */
+
+#define THREAD_NUM_CORES            LOCKS_NUM_CORES
+#define THREAD_MAX                  5                       /* Threads per core, including the main thread          */
+#if LOCKS_HOST
+#define THREAD_STACK_SIZE           16384                   /* The host keeps whole register frames on the stack    */
+#else
+#define THREAD_STACK_SIZE           1024                    /* Bytes, only locals and arguments, see the CSAs       */
+#endif
+#define THREAD_CSA_SIZE             64                      /* Bytes of one context save area                       */
+#define ISR_PRIORITY_THREAD_SLICE   2                       /* Lowest priority, preempts only threads               */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*ThreadFunction)(void *arg);
+
+typedef enum
+{
+    ThreadState_free,
+    ThreadState_ready,                                      /* Running or waiting for its turn                      */
+    ThreadState_exited                                      /* Returned, resources freed by the next thread         */
+} ThreadState;
+
+typedef struct
+{
+#if LOCKS_HOST
+    ucontext_t context;
+#else
+    uint32 pcxi;                                            /* Head of the saved CSA chain                          */
+#endif
+    uint32 icr;                                             /* Interrupt state to restore on resume                 */
+    ThreadFunction function;
+    void *arg;
+    ThreadState state;
+    uint32 switches;                                        /* Times the thread was resumed                         */
+} Thread;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initThreads(void);
+Thread *createThread(ThreadFunction function, void *arg);
+void yieldThread(void);
+void exitThread(void);
+Thread *getCurrentThread(void);
+uint32 getReadyThreads(void);
+uint32 getThreadCsas(const Thread *thread);
+#if !LOCKS_HOST && USE_THREAD_SLICE
+void startThreadPreemption(uint32 sliceUs);
+void stopThreadPreemption(void);
+#endif
+
+#endif /* THREAD_H_ */
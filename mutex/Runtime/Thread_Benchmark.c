@@ -0,0 +1,134 @@
+/**********************************************************************************************************************
+ * \file Thread_Benchmark.c
+ * \brief Context switch cost and memory per thread of the stackful threads.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Thread_Benchmark.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+volatile uint32 g_threadBenchSwitchCycles = 0;
+volatile uint32 g_threadBenchThreadBytes = 0;
+volatile uint32 g_threadBenchThreadCsas = 0;
+volatile uint32 g_threadBenchNestedSwitches = 0;
+volatile uint32 g_threadBenchPreempted[2];
+volatile uint32 g_threadBenchErrors = 0;
+volatile uint32 g_threadBenchStop = 0;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void pingPongThread(void *arg)
+{
+    uint32 i;
+    (void)arg;
+
+    for(i = 0; i < THREAD_BENCH_SWITCHES; i++)
+    {
+        yieldThread();
+    }
+}
+
+/* Returns the sum of the levels below, yielding on the way down and up */
+static uint32 nested(uint32 level, uint32 seed)
+{
+    uint32 below;
+
+    yieldThread();
+    if(level == 0)
+    {
+        return seed;
+    }
+    below = nested(level - 1, seed + 1);
+    yieldThread();
+    return below + level;
+}
+
+static void nestedThread(void *arg)
+{
+    uint32 seed = (uint32)(unsigned long)arg;
+    uint32 expected = seed + THREAD_BENCH_DEPTH + (THREAD_BENCH_DEPTH * (THREAD_BENCH_DEPTH + 1)) / 2;
+
+    if(nested(THREAD_BENCH_DEPTH, seed) != expected)
+    {
+        g_threadBenchErrors++;
+    }
+}
+
+#if !LOCKS_HOST && USE_THREAD_SLICE
+static void spinningThread(void *arg)
+{
+    uint32 index = (uint32)arg;
+
+    while(!g_threadBenchStop)
+    {
+        g_threadBenchPreempted[index]++;
+    }
+}
+#endif
+
+static void waitForThreads(void)
+{
+    while(getReadyThreads() > 1)
+    {
+        yieldThread();
+    }
+}
+
+void runThreadBenchmark(void)
+{
+    Thread *self;
+    Thread *pingPong;
+    uint32 start;
+    uint32 switches;
+    uint32 i;
+
+    initThreads();
+    self = getCurrentThread();
+    g_threadBenchErrors = 0;
+
+    pingPong = createThread(pingPongThread, 0);
+    if(pingPong == 0)
+    {
+        g_threadBenchErrors++;
+        return;
+    }
+    yieldThread();                                          /* Back once the thread is switched out in its yield    */
+    g_threadBenchThreadCsas = getThreadCsas(pingPong);
+    g_threadBenchThreadBytes = sizeof(Thread) + THREAD_STACK_SIZE + g_threadBenchThreadCsas * THREAD_CSA_SIZE;
+
+    switches = self->switches;
+    start = cycle_count();
+    waitForThreads();
+    g_threadBenchSwitchCycles = (cycle_count() - start) / (2 * (self->switches - switches));
+
+    switches = self->switches;
+    for(i = 1; i < THREAD_MAX; i++)
+    {
+        if(createThread(nestedThread, (void *)(unsigned long)(i * 100)) == 0)
+        {
+            g_threadBenchErrors++;
+        }
+    }
+    waitForThreads();
+    g_threadBenchNestedSwitches = self->switches - switches;
+
+#if !LOCKS_HOST && USE_THREAD_SLICE
+    g_threadBenchPreempted[0] = 0;
+    g_threadBenchPreempted[1] = 0;
+    g_threadBenchStop = 0;
+    createThread(spinningThread, (void *)0);
+    createThread(spinningThread, (void *)1);
+    startThreadPreemption(THREAD_BENCH_SLICE_US);
+    while(g_threadBenchPreempted[0] < 1000000 || g_threadBenchPreempted[1] < 1000000)
+    {
+    }
+    g_threadBenchStop = 1;
+    waitForThreads();
+    stopThreadPreemption();
+#endif
+}
@@ -0,0 +1,45 @@
+/**********************************************************************************************************************
+ * \file Thread_Benchmark.h
+ * \brief Context switch cost and memory per thread of the stackful threads.
+ *
+ * The switch cost is measured with the main thread and one created thread yielding to each other. Every other
+ * created thread then runs a recursion of THREAD_BENCH_DEPTH calls and yields at every level, which is what nested
+ * blocking legacy code looks like, and the results are checked. On the target two threads that never yield finally
+ * have to share the core through the time slice interrupt.
+ *
+ * Memory of a thread is sizeof(Thread), THREAD_STACK_SIZE and the CSAs of THREAD_CSA_SIZE bytes holding the
+ * register frames of a switched out thread: one per active call level plus one for the lower context, counted on the
+ * ping-pong thread suspended in its yield. Single core, also on a Linux host, where the frames are on the stack.
+ *********************************************************************************************************************/
+
+#ifndef THREAD_BENCHMARK_H_
+#define THREAD_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Thread.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define THREAD_BENCH_SWITCHES       10000                   /* Yields of each of the two ping-pong threads          */
+#define THREAD_BENCH_DEPTH          8                       /* Call levels of the nested threads                    */
+#define THREAD_BENCH_SLICE_US       100                     /* Time slice of the preemption test on the target      */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile uint32 g_threadBenchSwitchCycles;           /* Cycles per yield (ns on the host)                    */
+extern volatile uint32 g_threadBenchThreadBytes;            /* Thread, stack and CSAs of a switched out thread      */
+extern volatile uint32 g_threadBenchThreadCsas;             /* CSAs of a thread suspended in yieldThread()          */
+extern volatile uint32 g_threadBenchNestedSwitches;         /* Switches of the nested threads                       */
+extern volatile uint32 g_threadBenchPreempted[2];           /* Progress of the two never yielding threads           */
+extern volatile uint32 g_threadBenchErrors;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runThreadBenchmark(void);
+
+#endif /* THREAD_BENCHMARK_H_ */
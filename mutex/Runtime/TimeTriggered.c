@@ -0,0 +1,326 @@
+/**********************************************************************************************************************
+ * \file TimeTriggered.c
+ * \brief Per-core time-triggered cyclic executive driven by STM compare-match interrupts.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "TimeTriggered.h"
+#if !LOCKS_HOST
+#include "Ifx_Types.h"
+#include "IfxCpu.h"
+#include "IfxStm.h"
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* The executive of a core is only touched by that core */
+#pragma section fardata "data_cpu0"
+TtExecutive g_ttCpu0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu1"
+TtExecutive g_ttCpu1;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu2"
+TtExecutive g_ttCpu2;
+#pragma section fardata restore
+
+TtExecutive *const g_tt[TT_NUM_CORES] = {&g_ttCpu0, &g_ttCpu1, &g_ttCpu2};
+
+#if LOCKS_HOST
+volatile uint32 g_ttSimulatedTime[TT_NUM_CORES];            /* Microseconds                                         */
+#else
+static Ifx_STM *const g_ttStm[TT_NUM_CORES] = {&MODULE_STM0, &MODULE_STM1, &MODULE_STM2};
+static const IfxSrc_Tos g_ttTos[TT_NUM_CORES] = {IfxSrc_Tos_cpu0, IfxSrc_Tos_cpu1, IfxSrc_Tos_cpu2};
+#endif
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static uint32 now(uint32 core)
+{
+#if LOCKS_HOST
+    return g_ttSimulatedTime[core];
+#else
+    return IfxStm_getLower(g_ttStm[core]);
+#endif
+}
+
+/* Heaviest frame the task would share with the given offset */
+static uint32 offsetCost(const uint32 *load, uint32 periodMs, uint32 offsetMs)
+{
+    uint32 cost = 0;
+    uint32 frame;
+
+    for(frame = offsetMs; frame < TT_HYPERPERIOD_MS; frame += periodMs)
+    {
+        if(load[frame] > cost)
+        {
+            cost = load[frame];
+        }
+    }
+    return cost;
+}
+
+static void addLoad(uint32 *load, uint32 periodMs, uint32 offsetMs, uint32 budgetUs)
+{
+    uint32 frame;
+
+    for(frame = offsetMs; frame < TT_HYPERPERIOD_MS; frame += periodMs)
+    {
+        load[frame] += (budgetUs != 0) ? budgetUs : 1;
+    }
+}
+
+/* Sets up the executive of the calling core, the first frame starts one millisecond after startTicks.
+ * The tasks with fixed offsets are placed first, then those with TT_OFFSET_AUTO from the shortest period up, each
+ * into the offset whose heaviest frame is lightest. FALSE if a period does not divide TT_HYPERPERIOD_MS, a fixed
+ * offset is not below its period or the table is too long.
+ */
+boolean initTimeTriggered(const TtTaskConfig *table, uint32 count, uint32 ticksPerMs, uint32 startTicks)
+{
+    TtExecutive *executive = g_tt[core_id()];
+    uint32 load[TT_HYPERPERIOD_MS];
+    uint32 periodMs;
+    uint32 i;
+
+    if(count > TT_MAX_TASKS)
+    {
+        return FALSE;
+    }
+    for(i = 0; i < TT_HYPERPERIOD_MS; i++)
+    {
+        load[i] = 0;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        periodMs = table[i].periodMs;
+        if(periodMs == 0 || (TT_HYPERPERIOD_MS % periodMs) != 0)
+        {
+            return FALSE;
+        }
+        if(table[i].offsetMs != TT_OFFSET_AUTO)
+        {
+            if(table[i].offsetMs >= periodMs)
+            {
+                return FALSE;
+            }
+            executive->stats[i].offsetMs = table[i].offsetMs;
+            addLoad(load, periodMs, table[i].offsetMs, table[i].budgetUs);
+        }
+    }
+
+    for(periodMs = 1; periodMs <= TT_HYPERPERIOD_MS; periodMs++)
+    {
+        for(i = 0; i < count; i++)
+        {
+            if(table[i].periodMs == periodMs && table[i].offsetMs == TT_OFFSET_AUTO)
+            {
+                uint32 best = 0;
+                uint32 bestCost = offsetCost(load, periodMs, 0);
+                uint32 offsetMs;
+
+                for(offsetMs = 1; offsetMs < periodMs; offsetMs++)
+                {
+                    uint32 cost = offsetCost(load, periodMs, offsetMs);
+                    if(cost < bestCost)
+                    {
+                        best = offsetMs;
+                        bestCost = cost;
+                    }
+                }
+                executive->stats[i].offsetMs = best;
+                addLoad(load, periodMs, best, table[i].budgetUs);
+            }
+        }
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        executive->stats[i].releases = 0;
+        executive->stats[i].minStartDelay = 0xFFFFFFFF;
+        executive->stats[i].maxStartDelay = 0;
+        executive->stats[i].maxExecution = 0;
+        executive->stats[i].overruns = 0;
+    }
+    executive->table = table;
+    executive->count = count;
+    executive->ticksPerMs = ticksPerMs;
+    executive->frame = 0;
+    executive->release = startTicks + ticksPerMs;
+    executive->frames = 0;
+    executive->lateFrames = 0;
+    return TRUE;
+}
+
+/* Runs the tasks of the current frame of the calling core and returns the release time of the next frame.
+ * Called from the frame interrupt once the release time of the current frame has been reached.
+ */
+uint32 runTimeTriggeredFrame(void)
+{
+    uint32 core = core_id();
+    TtExecutive *executive = g_tt[core];
+    uint32 frameEnd = executive->release + executive->ticksPerMs;
+    uint32 i;
+
+    if((sint32)(now(core) - frameEnd) >= 0)
+    {
+        executive->lateFrames++;
+    }
+
+    for(i = 0; i < executive->count; i++)
+    {
+        const TtTaskConfig *task = &executive->table[i];
+        TtTaskStats *stats = &executive->stats[i];
+        uint32 start;
+        uint32 end;
+
+        if((executive->frame % task->periodMs) != stats->offsetMs)
+        {
+            continue;
+        }
+
+        start = now(core);
+        task->function();
+#if LOCKS_HOST
+        consumeSimulatedTime(task->budgetUs * executive->ticksPerMs / 1000);
+#endif
+        end = now(core);
+
+        stats->releases++;
+        if((start - executive->release) < stats->minStartDelay)
+        {
+            stats->minStartDelay = start - executive->release;
+        }
+        if((start - executive->release) > stats->maxStartDelay)
+        {
+            stats->maxStartDelay = start - executive->release;
+        }
+        if((end - start) > stats->maxExecution)
+        {
+            stats->maxExecution = end - start;
+        }
+        if((sint32)(end - frameEnd) > 0)
+        {
+            stats->overruns++;
+        }
+    }
+
+    executive->frames++;
+    executive->frame = (executive->frame + 1) % TT_HYPERPERIOD_MS;
+    executive->release = frameEnd;
+    return frameEnd;
+}
+
+TtExecutive *getTimeTriggeredExecutive(uint32 core)
+{
+    return g_tt[core];
+}
+
+/* Spread of the start delay of a task in ticks */
+uint32 getTimeTriggeredJitter(uint32 core, uint32 task)
+{
+    TtTaskStats *stats = &g_tt[core]->stats[task];
+
+    return (stats->releases != 0) ? (stats->maxStartDelay - stats->minStartDelay) : 0;
+}
+
+#if LOCKS_HOST
+
+/* Runs the given number of frames of the calling core, idling up to the release of each */
+void runTimeTriggeredSimulation(uint32 frames)
+{
+    uint32 core = core_id();
+    TtExecutive *executive = g_tt[core];
+
+    while(frames-- != 0)
+    {
+        if((sint32)(g_ttSimulatedTime[core] - executive->release) < 0)
+        {
+            g_ttSimulatedTime[core] = executive->release;
+        }
+        runTimeTriggeredFrame();
+    }
+}
+
+uint32 getSimulatedTime(void)
+{
+    return g_ttSimulatedTime[core_id()];
+}
+
+/* Lets a task take longer than its budget, e.g. to provoke an overrun */
+void consumeSimulatedTime(uint32 ticks)
+{
+    g_ttSimulatedTime[core_id()] += ticks;
+}
+
+#else
+
+IFX_INTERRUPT(timeTriggeredIsrCpu0, 0, ISR_PRIORITY_TT);
+IFX_INTERRUPT(timeTriggeredIsrCpu1, 1, ISR_PRIORITY_TT);
+IFX_INTERRUPT(timeTriggeredIsrCpu2, 2, ISR_PRIORITY_TT);
+
+/* Runs every frame that is due and moves the compare value to the next release. Late frames are caught up here,
+ * a compare value already in the past would only match after the 32 bit timer wrapped.
+ */
+static void runDueFrames(uint32 core)
+{
+    Ifx_STM *stm = g_ttStm[core];
+    TtExecutive *executive = g_tt[core];
+
+    IfxStm_clearCompareFlag(stm, IfxStm_Comparator_0);
+    do
+    {
+        while((sint32)(IfxStm_getLower(stm) - executive->release) >= 0)
+        {
+            runTimeTriggeredFrame();
+        }
+        IfxStm_updateCompare(stm, IfxStm_Comparator_0, executive->release);
+    } while((sint32)(IfxStm_getLower(stm) - executive->release) >= 0);
+}
+
+void timeTriggeredIsrCpu0(void)
+{
+    runDueFrames(0);
+}
+
+void timeTriggeredIsrCpu1(void)
+{
+    runDueFrames(1);
+}
+
+void timeTriggeredIsrCpu2(void)
+{
+    runDueFrames(2);
+}
+
+/* Starts the schedule table on the calling core with its own STM, to be called once per core */
+boolean startTimeTriggered(const TtTaskConfig *table, uint32 count)
+{
+    uint32 core = (uint32)IfxCpu_getCoreIndex();
+    Ifx_STM *stm = g_ttStm[core];
+    IfxStm_CompareConfig config;
+    uint32 ticksPerMs = (uint32)IfxStm_getTicksFromMilliseconds(stm, 1);
+
+    if(!initTimeTriggered(table, count, ticksPerMs, IfxStm_getLower(stm)))
+    {
+        return FALSE;
+    }
+
+    IfxStm_initCompareConfig(&config);
+    config.comparator = IfxStm_Comparator_0;
+    config.comparatorInterrupt = IfxStm_ComparatorInterrupt_ir0;
+    config.ticks = ticksPerMs;
+    config.triggerPriority = ISR_PRIORITY_TT;
+    config.typeOfService = g_ttTos[core];
+    IfxStm_initCompare(stm, &config);
+    IfxStm_updateCompare(stm, IfxStm_Comparator_0, g_tt[core]->release);
+    return TRUE;
+}
+
+#endif
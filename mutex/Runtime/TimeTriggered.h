@@ -0,0 +1,85 @@
+/**********************************************************************************************************************
+ * \file TimeTriggered.h
+ * \brief Per-core time-triggered cyclic executive driven by STM compare-match interrupts.
+ *
+ * Every core runs its own static schedule table of periodic tasks (periods dividing TT_HYPERPERIOD_MS, e.g. 1, 10
+ * and 100 ms) from a 1 ms frame interrupt of its own STM: core n uses STMn comparator 0. The tasks of a frame run to
+ * completion inside the frame interrupt, in table order. Instead of every 10 ms and 100 ms task piling up in frame 0,
+ * tasks with TT_OFFSET_AUTO are moved to the frame offset with the smallest load, weighted by their budget.
+ * For every task the start delay after its release (jitter = max - min) and the overruns, i.e. finishing after the
+ * end of the frame and so delaying the next one, are recorded.
+ *
+ * With LOCKS_HOST=1 the STM is replaced by a simulated clock per core: runTimeTriggeredSimulation() advances it frame
+ * by frame and lets every task consume its budget, so offsets and overruns of a table can be checked on a PC.
+ *********************************************************************************************************************/
+
+#ifndef TIMETRIGGERED_H_
+#define TIMETRIGGERED_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define TT_NUM_CORES                LOCKS_NUM_CORES
+#define TT_MAX_TASKS                16                      /* Tasks per core                                       */
+#define TT_HYPERPERIOD_MS           100                     /* All periods have to divide it                        */
+#define TT_OFFSET_AUTO              0xFFFFFFFF              /* Let initTimeTriggered() choose the offset            */
+#define ISR_PRIORITY_TT             40                      /* Priority of the STM frame interrupt on every core    */
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*TtTaskFunction)(void);
+
+/* One entry of a static schedule table */
+typedef struct
+{
+    TtTaskFunction function;
+    uint32 periodMs;
+    uint32 offsetMs;                                        /* Frame within the period or TT_OFFSET_AUTO            */
+    uint32 budgetUs;                                        /* Expected execution time, weight of the offset choice */
+} TtTaskConfig;
+
+typedef struct
+{
+    uint32 offsetMs;                                        /* Offset in use                                        */
+    uint32 releases;
+    uint32 minStartDelay;                                   /* Ticks from the release to the start of the task      */
+    uint32 maxStartDelay;
+    uint32 maxExecution;                                    /* Ticks from the start to the end of the task          */
+    uint32 overruns;                                        /* Task ended after the end of its frame                */
+} TtTaskStats;
+
+typedef struct
+{
+    const TtTaskConfig *table;
+    uint32 count;
+    uint32 ticksPerMs;
+    uint32 frame;                                           /* Frame number within the hyperperiod                  */
+    uint32 release;                                         /* Nominal start of the current frame in ticks          */
+    uint32 frames;                                          /* Frames run                                           */
+    uint32 lateFrames;                                      /* Frames started only after their end, caught up       */
+    TtTaskStats stats[TT_MAX_TASKS];
+} TtExecutive;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+boolean initTimeTriggered(const TtTaskConfig *table, uint32 count, uint32 ticksPerMs, uint32 startTicks);
+uint32 runTimeTriggeredFrame(void);
+TtExecutive *getTimeTriggeredExecutive(uint32 core);
+uint32 getTimeTriggeredJitter(uint32 core, uint32 task);
+
+#if LOCKS_HOST
+void runTimeTriggeredSimulation(uint32 frames);
+uint32 getSimulatedTime(void);
+void consumeSimulatedTime(uint32 ticks);
+#else
+boolean startTimeTriggered(const TtTaskConfig *table, uint32 count);
+#endif
+
+#endif /* TIMETRIGGERED_H_ */
@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * \file TimeTriggered_Example.c
+ * \brief Schedule tables of 1, 10 and 100 ms tasks on all cores, replacing the blocking wait loops.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "TimeTriggered_Example.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+volatile uint32 g_ttExampleSamples = 0;
+volatile uint32 g_ttExampleLedState = 0;
+volatile uint32 g_ttExampleFiltered = 0;
+volatile uint32 g_ttExampleOutput = 0;
+volatile uint32 g_ttExampleDiagnostics = 0;
+volatile uint32 g_ttExampleHousekeeping[TT_NUM_CORES];
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Prototypes---------------------------------------------------*/
+/*********************************************************************************************************************/
+static void sampleTask(void);
+static void filterTask(void);
+static void controlTask(void);
+static void ledTask(void);
+static void diagnosticTask(void);
+static void housekeepingTask(void);
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Schedule tables--------------------------------------------------*/
+/*********************************************************************************************************************/
+static const TtTaskConfig g_ttExampleCpu0[] =
+{
+    {sampleTask,       1,   0,              50},
+    {filterTask,       10,  TT_OFFSET_AUTO, 200},
+    {controlTask,      10,  TT_OFFSET_AUTO, 200},
+    {ledTask,          100, TT_OFFSET_AUTO, 20},
+    {diagnosticTask,   100, TT_OFFSET_AUTO, 300}
+};
+
+static const TtTaskConfig g_ttExampleCpu12[] =
+{
+    {housekeepingTask, 10,  TT_OFFSET_AUTO, 100},
+    {housekeepingTask, 100, TT_OFFSET_AUTO, 400}
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void sampleTask(void)
+{
+    g_ttExampleSamples++;
+}
+
+static void filterTask(void)
+{
+    g_ttExampleFiltered = (g_ttExampleFiltered * 3 + g_ttExampleSamples) >> 2;
+}
+
+static void controlTask(void)
+{
+    g_ttExampleOutput = g_ttExampleFiltered >> 1;
+}
+
+static void ledTask(void)
+{
+    g_ttExampleLedState ^= 1;
+}
+
+static void diagnosticTask(void)
+{
+    g_ttExampleDiagnostics++;
+#if LOCKS_HOST
+    if((g_ttExampleDiagnostics % 5) == 0)
+    {
+        consumeSimulatedTime(1500);
+    }
+#endif
+}
+
+static void housekeepingTask(void)
+{
+    g_ttExampleHousekeeping[core_id()]++;
+}
+
+void runTimeTriggeredExample(void)
+{
+    const TtTaskConfig *table = (core_id() == 0) ? g_ttExampleCpu0 : g_ttExampleCpu12;
+    uint32 count = (core_id() == 0) ? (sizeof(g_ttExampleCpu0) / sizeof(g_ttExampleCpu0[0]))
+                                    : (sizeof(g_ttExampleCpu12) / sizeof(g_ttExampleCpu12[0]));
+
+#if LOCKS_HOST
+    initTimeTriggered(table, count, 1000, getSimulatedTime());
+    runTimeTriggeredSimulation(TT_EXAMPLE_FRAMES);
+#else
+    startTimeTriggered(table, count);
+    while(1)
+    {
+        __asm("wait");                                      /* Sleep between the frame interrupts                   */
+    }
+#endif
+}
@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+ * \file TimeTriggered_Example.h
+ * \brief Schedule tables of 1, 10 and 100 ms tasks on all cores, replacing the blocking wait loops.
+ *
+ * Core 0 samples every millisecond, filters and controls every 10 ms and toggles the LED state and runs a diagnostic
+ * every 100 ms; cores 1 and 2 run smaller tables. Only the 1 ms task has a fixed offset, the others are spread by
+ * initTimeTriggered(). To be called by all cores, on a Linux host with RunOnHostCores(runTimeTriggeredExample, 3) the
+ * tables run for TT_EXAMPLE_FRAMES simulated frames; there every fifth diagnostic run takes 1.5 ms to show an overrun.
+ *********************************************************************************************************************/
+
+#ifndef TIMETRIGGERED_EXAMPLE_H_
+#define TIMETRIGGERED_EXAMPLE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "TimeTriggered.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define TT_EXAMPLE_FRAMES           1000                    /* Simulated frames on the host                         */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+extern volatile uint32 g_ttExampleSamples;
+extern volatile uint32 g_ttExampleLedState;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runTimeTriggeredExample(void);
+
+#endif /* TIMETRIGGERED_EXAMPLE_H_ */
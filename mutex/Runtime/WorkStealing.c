@@ -0,0 +1,303 @@
+/**********************************************************************************************************************
+ * \file WorkStealing.c
+ * \brief Work-stealing task runtime across the TriCore cores.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "WorkStealing.h"
+#include "Locks/sync_wait.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define WS_DEQUE_MASK               (WS_DEQUE_SIZE - 1)
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+/* The owner works on its deque all the time, thieves only now and then */
+#pragma section fardata "data_cpu0"
+WsDeque g_wsDequeCpu0;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu1"
+WsDeque g_wsDequeCpu1;
+#pragma section fardata restore
+
+#pragma section fardata "data_cpu2"
+WsDeque g_wsDequeCpu2;
+#pragma section fardata restore
+
+WsDeque *const g_wsDeque[WS_NUM_CORES] = {&g_wsDequeCpu0, &g_wsDequeCpu1, &g_wsDequeCpu2};
+
+#pragma section fardata "lmudata"
+WsTask g_wsTask[WS_MAX_TASKS];                              /* Task descriptor pool                                 */
+unsigned short g_wsTaskNext[WS_MAX_TASKS];                  /* Links of the free list and of the inboxes            */
+freelist_t g_wsFreeTasks;
+freelist_t g_wsInbox[WS_NUM_CORES];                         /* Tasks submitted to a core by others or by ISRs       */
+WsCoreStats g_wsStats[WS_NUM_CORES];
+volatile uint32 g_wsActiveCores = WS_NUM_CORES;
+volatile uint32 g_wsStop = 0;
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+/* Owner only */
+static boolean pushDeque(WsDeque *deque, uint32 task)
+{
+    uint32 bottom = deque->bottom;
+
+    if((bottom - deque->top) >= WS_DEQUE_SIZE)
+    {
+        return FALSE;
+    }
+    deque->entry[bottom & WS_DEQUE_MASK] = task;
+    memory_barrier();                                       /* Entry visible before thieves can see it              */
+    deque->bottom = bottom + 1;
+    return TRUE;
+}
+
+/* Owner only, takes the most recently pushed task */
+static uint32 popDeque(WsDeque *deque)
+{
+    uint32 bottom = deque->bottom - 1;
+    uint32 top;
+    uint32 task;
+
+    deque->bottom = bottom;
+    memory_barrier();                                       /* Claim the entry before looking at the thieves        */
+    top = deque->top;
+
+    if((sint32)(bottom - top) < 0)
+    {
+        deque->bottom = bottom + 1;                         /* Empty                                                */
+        return WS_NO_TASK;
+    }
+
+    task = deque->entry[bottom & WS_DEQUE_MASK];
+    if(bottom == top)
+    {
+        /* Last entry: race against the thieves for it */
+        if(!cmp_swap((unsigned int *)&deque->top, top, top + 1))
+        {
+            task = WS_NO_TASK;
+        }
+        deque->bottom = bottom + 1;
+    }
+    return task;
+}
+
+/* Any core, takes the oldest task */
+static uint32 stealDeque(WsDeque *deque)
+{
+    uint32 top = deque->top;
+    uint32 task;
+
+    memory_barrier();
+    if((sint32)(deque->bottom - top) <= 0)
+    {
+        return WS_NO_TASK;
+    }
+    task = deque->entry[top & WS_DEQUE_MASK];
+    if(!cmp_swap((unsigned int *)&deque->top, top, top + 1))
+    {
+        return WS_NO_TASK;                                  /* Another thief or the owner was faster                */
+    }
+    return task;
+}
+
+static void executeTask(uint32 index)
+{
+    WsTask *task = &g_wsTask[index];
+    WsTaskFunction function = task->function;
+    void *arg = task->arg;
+    WsGroup *group = task->group;
+
+    memory_barrier();
+    PushFreeList(&g_wsFreeTasks, index);
+
+    function(arg);
+
+    memory_barrier();                                       /* Results visible before the group counts the task     */
+    swap_add(&group->pending, (uint32)-1);
+    g_wsStats[core_id()].executed++;
+}
+
+static uint32 allocTask(WsGroup *group, WsTaskFunction function, void *arg)
+{
+    uint32 index = PopFreeList(&g_wsFreeTasks);
+
+    if(index != WS_NO_TASK)
+    {
+        g_wsTask[index].function = function;
+        g_wsTask[index].arg = arg;
+        g_wsTask[index].group = group;
+        swap_incr(&group->pending);
+    }
+    return index;
+}
+
+/* Moves the tasks handed over by other cores and ISRs into the own deque */
+static void drainInbox(uint32 core)
+{
+    uint32 index;
+
+    while((index = PopFreeList(&g_wsInbox[core])) != WS_NO_TASK)
+    {
+        if(!pushDeque(g_wsDeque[core], index))
+        {
+            executeTask(index);
+        }
+    }
+}
+
+/* Has to be called once before any core uses the runtime, with the cores 0..activeCores-1 taking part */
+void initWorkStealing(uint32 activeCores)
+{
+    uint32 core;
+
+    InitFreeList(&g_wsFreeTasks, g_wsTaskNext, WS_MAX_TASKS, TRUE);
+    for(core = 0; core < WS_NUM_CORES; core++)
+    {
+        g_wsInbox[core].next = g_wsTaskNext;
+        g_wsInbox[core].size = WS_MAX_TASKS;
+        g_wsInbox[core].head = freelistEMPTY;
+        g_wsDeque[core]->top = 0;
+        g_wsDeque[core]->bottom = 0;
+        g_wsStats[core].executed = 0;
+        g_wsStats[core].stolen = 0;
+        g_wsStats[core].failedSteals = 0;
+    }
+    g_wsActiveCores = (activeCores > WS_NUM_CORES) ? WS_NUM_CORES : activeCores;
+    g_wsStop = 0;
+    memory_barrier();
+}
+
+/* Spawns a task on the calling core, task level only (ISRs use submitTaskTo()).
+ * If no descriptor or deque entry is free the task is run right away and FALSE is returned.
+ */
+boolean spawnTask(WsGroup *group, WsTaskFunction function, void *arg)
+{
+    uint32 core = core_id();
+    uint32 index = allocTask(group, function, arg);
+
+    if(index == WS_NO_TASK)
+    {
+        function(arg);
+        return FALSE;
+    }
+    if(!pushDeque(g_wsDeque[core], index))
+    {
+        executeTask(index);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/* Hands a task to the given core, from any core or ISR. FALSE if no descriptor is free or the core does not
+ * take part.
+ */
+boolean submitTaskTo(uint32 core, WsGroup *group, WsTaskFunction function, void *arg)
+{
+    uint32 index;
+
+    if(core >= g_wsActiveCores)
+    {
+        return FALSE;
+    }
+    index = allocTask(group, function, arg);
+    if(index == WS_NO_TASK)
+    {
+        return FALSE;
+    }
+    PushFreeList(&g_wsInbox[core], index);
+    return TRUE;
+}
+
+/* Runs one task of the own deque or, if that is empty, one stolen from another core */
+boolean runOneTask(void)
+{
+    uint32 core = core_id();
+    uint32 active = g_wsActiveCores;
+    uint32 index;
+    uint32 i;
+
+    drainInbox(core);
+    index = popDeque(g_wsDeque[core]);
+    if(index != WS_NO_TASK)
+    {
+        executeTask(index);
+        return TRUE;
+    }
+
+    for(i = 1; i < active; i++)
+    {
+        uint32 victim = (core + i) % active;
+
+        index = stealDeque(g_wsDeque[victim]);
+        if(index != WS_NO_TASK)
+        {
+            g_wsStats[core].stolen++;
+            executeTask(index);
+            return TRUE;
+        }
+    }
+    g_wsStats[core].failedSteals++;
+    return FALSE;
+}
+
+/* Waits until all tasks of the group are done, running tasks meanwhile */
+void waitTaskGroup(WsGroup *group)
+{
+    syncwait_t wait = SYNCWAIT_INIT;
+
+    while(*(volatile uint32 *)&group->pending != 0)
+    {
+        if(runOneTask())
+        {
+            wait.spins = 0;
+            wait.delay = 1;
+        }
+        else
+        {
+            SyncWait(&wait);
+        }
+    }
+    memory_barrier();
+}
+
+/* Main loop of a worker core, returns after stopWorkStealing() */
+void runWorkStealingWorker(void)
+{
+    syncwait_t wait = SYNCWAIT_INIT;
+
+    if(core_id() >= g_wsActiveCores)
+    {
+        return;
+    }
+    while(!g_wsStop)
+    {
+        if(runOneTask())
+        {
+            wait.spins = 0;
+            wait.delay = 1;
+        }
+        else
+        {
+            SyncWait(&wait);
+        }
+    }
+}
+
+void stopWorkStealing(void)
+{
+    g_wsStop = 1;
+}
+
+WsCoreStats *getWorkStealingStats(uint32 core)
+{
+    return &g_wsStats[core];
+}
@@ -0,0 +1,80 @@
+/**********************************************************************************************************************
+ * \file WorkStealing.h
+ * \brief Work-stealing task runtime across the TriCore cores.
+ *
+ * Every participating core owns a Chase-Lev deque: it pushes and pops its own tasks at the bottom without any atomic
+ * instruction in the common case, idle cores steal from the top of the other deques with one cmp_swap. Tasks from
+ * other cores and from ISRs are handed over through a lock-free inbox per core and moved into the deque by the owner.
+ * Task descriptors come from a static pool, nothing is allocated at run time.
+ *
+ * Usage: core 0 calls initWorkStealing() before the other cores start, cores 1 and 2 call runWorkStealingWorker()
+ * from core1_main/core2_main. Any core spawns tasks into a WsGroup and waits for the group with waitTaskGroup(), which
+ * runs tasks itself while waiting. stopWorkStealing() lets the workers return.
+ *
+ * Builds unchanged on a Linux host with LOCKS_HOST=1, every core being a pthread (see Locks/host_port.h).
+ *********************************************************************************************************************/
+
+#ifndef WORKSTEALING_H_
+#define WORKSTEALING_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Locks/atomic_instructions.h"
+#include "Locks/freelist.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define WS_NUM_CORES                LOCKS_NUM_CORES
+#define WS_MAX_TASKS                256                     /* Task descriptors in the pool                         */
+#define WS_DEQUE_SIZE               128                     /* Entries per deque, power of two                      */
+#define WS_NO_TASK                  freelistEMPTY
+
+/*********************************************************************************************************************/
+/*--------------------------------------------------Data Structures--------------------------------------------------*/
+/*********************************************************************************************************************/
+typedef void (*WsTaskFunction)(void *arg);
+
+/* Completion counter of a set of tasks, e.g. the children of a fork */
+typedef struct
+{
+    uint32 pending;                                         /* Spawned but not finished tasks, atomic               */
+} WsGroup;
+
+#define WS_GROUP_INIT               {0}
+
+typedef struct
+{
+    WsTaskFunction function;
+    void *arg;
+    WsGroup *group;
+} WsTask;
+
+typedef struct
+{
+    volatile uint32 top;                                    /* Next entry to steal, advanced with cmp_swap          */
+    volatile uint32 bottom;                                 /* Next free entry, written by the owner only           */
+    volatile uint32 entry[WS_DEQUE_SIZE];                   /* Task indices                                         */
+} WsDeque;
+
+typedef struct
+{
+    volatile uint32 executed;                               /* Tasks run by this core                               */
+    volatile uint32 stolen;                                 /* Tasks this core took from another deque              */
+    volatile uint32 failedSteals;                           /* Steal attempts that found nothing or lost the race   */
+} WsCoreStats;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void initWorkStealing(uint32 activeCores);
+boolean spawnTask(WsGroup *group, WsTaskFunction function, void *arg);
+boolean submitTaskTo(uint32 core, WsGroup *group, WsTaskFunction function, void *arg);
+void waitTaskGroup(WsGroup *group);
+boolean runOneTask(void);
+void runWorkStealingWorker(void);
+void stopWorkStealing(void);
+WsCoreStats *getWorkStealingStats(uint32 core);
+
+#endif /* WORKSTEALING_H_ */
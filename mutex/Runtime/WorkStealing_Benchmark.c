@@ -0,0 +1,112 @@
+/**********************************************************************************************************************
+ * \file WorkStealing_Benchmark.c
+ * \brief Scaling of the work-stealing runtime with synthetic task graphs on 1, 2 and 3 cores.
+ *********************************************************************************************************************/
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "WorkStealing_Benchmark.h"
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+#pragma section fardata "lmudata"
+volatile uint32 g_wsBenchTreeCycles[WS_NUM_CORES];
+volatile uint32 g_wsBenchFlatCycles[WS_NUM_CORES];
+volatile uint32 g_wsBenchLeaves = 0;
+volatile uint32 g_wsBenchRound = 0;
+volatile uint32 g_wsBenchDone[WS_NUM_CORES];
+#pragma section fardata restore
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+static void leafWork(void)
+{
+    volatile uint32 i;
+    for(i = 0; i < WS_BENCH_LEAF_WORK; i++)
+    {
+    }
+}
+
+/* arg is the remaining depth of the subtree */
+static void treeTask(void *arg)
+{
+    unsigned long depth = (unsigned long)arg;
+    WsGroup children = WS_GROUP_INIT;
+
+    if(depth == 0)
+    {
+        leafWork();
+        swap_incr((unsigned int *)&g_wsBenchLeaves);
+        return;
+    }
+    spawnTask(&children, treeTask, (void *)(depth - 1));
+    spawnTask(&children, treeTask, (void *)(depth - 1));
+    waitTaskGroup(&children);
+}
+
+static void flatTask(void *arg)
+{
+    (void)arg;
+    leafWork();
+}
+
+static void runGraphs(uint32 round)
+{
+    WsGroup group = WS_GROUP_INIT;
+    uint32 start;
+    uint32 i;
+
+    g_wsBenchLeaves = 0;
+    start = cycle_count();
+    spawnTask(&group, treeTask, (void *)(unsigned long)WS_BENCH_TREE_DEPTH);
+    waitTaskGroup(&group);
+    g_wsBenchTreeCycles[round] = cycle_count() - start;
+
+    start = cycle_count();
+    for(i = 0; i < WS_BENCH_FLAT_TASKS; i++)
+    {
+        spawnTask(&group, flatTask, 0);
+    }
+    waitTaskGroup(&group);
+    g_wsBenchFlatCycles[round] = cycle_count() - start;
+}
+
+void runWorkStealingBenchmark(void)
+{
+    uint32 core = core_id();
+    uint32 cores;
+    uint32 i;
+
+    for(cores = 1; cores <= WS_NUM_CORES; cores++)
+    {
+        if(core == 0)
+        {
+            initWorkStealing(cores);
+            g_wsBenchRound = cores;
+
+            runGraphs(cores - 1);
+
+            stopWorkStealing();
+            for(i = 1; i < WS_NUM_CORES; i++)
+            {
+                while(g_wsBenchDone[i] != cores)
+                {
+                    __nop();
+                }
+            }
+        }
+        else
+        {
+            while(g_wsBenchRound != cores)
+            {
+                __nop();
+            }
+            runWorkStealingWorker();
+            memory_barrier();
+            g_wsBenchDone[core] = cores;
+        }
+    }
+}
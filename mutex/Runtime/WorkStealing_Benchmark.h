@@ -0,0 +1,38 @@
+/**********************************************************************************************************************
+ * \file WorkStealing_Benchmark.h
+ * \brief Scaling of the work-stealing runtime with synthetic task graphs on 1, 2 and 3 cores.
+ *
+ * Two graphs are run: a binary fork-join tree (every task spawns two children and waits for them) and a flat set of
+ * independent tasks all spawned by core 0, which the other cores only get by stealing. To be called by all cores at
+ * the same time, on a Linux host with RunOnHostCores(runWorkStealingBenchmark, 3).
+ *********************************************************************************************************************/
+
+#ifndef WORKSTEALING_BENCHMARK_H_
+#define WORKSTEALING_BENCHMARK_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "WorkStealing.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define WS_BENCH_TREE_DEPTH         10                      /* 2^10 leaves                                          */
+#define WS_BENCH_FLAT_TASKS         1000
+#define WS_BENCH_LEAF_WORK          2000                    /* Loop iterations of one leaf / flat task              */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Global variables---------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Cycles (nanoseconds on the host) per graph, index 0..2 = 1..3 cores */
+extern volatile uint32 g_wsBenchTreeCycles[WS_NUM_CORES];
+extern volatile uint32 g_wsBenchFlatCycles[WS_NUM_CORES];
+extern volatile uint32 g_wsBenchLeaves;                     /* Leaves run in the last tree, as a sanity check       */
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+void runWorkStealingBenchmark(void);
+
+#endif /* WORKSTEALING_BENCHMARK_H_ */